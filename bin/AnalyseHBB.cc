@@ -8,12 +8,14 @@ namespace po = boost::program_options;
 #include <vector>
 #include <chrono>
 #include <algorithm>
+#include <cstdlib>
 
 #include "Analysis/Core/interface/Analysis.h"
 #include "TFile.h" 
 #include "TFileCollection.h"
 #include "TChain.h"
 #include "TH1.h"
+#include "TParameter.h"
 
 using namespace analysis;
 using namespace analysis::tools;
@@ -54,6 +56,7 @@ public:
 		_nsel.assign(cut_descriptions.size(), 0);
 		_cur_cut = 0;
 		started = false;
+		_previous_duration = 0;
 	}
 
 	//Inform that the next even is being processed.
@@ -94,17 +97,38 @@ public:
 		return _nsel;
 	}
 
+	std::vector<unsigned int>& get_nsel() {
+		return _nsel;
+	}
+
 	float get_effeciency() {
 		if (_nsel.front() == 0)
 			return 1.;
 		return (float) _nsel.back() / _nsel.front();
 	}
 
+	//Write the counts to the current directory as a histogram with one
+	//labelled bin per cut, so that those of several jobs can be added up,
+	//e.g. by hadd or analysis-run.
+	void write(const std::string& name) const {
+		TH1D h(name.c_str(), _title.c_str(), _nsel.size(), 0., _nsel.size());
+		for (unsigned int i = 0; i < _nsel.size(); ++i) {
+			h.GetXaxis()->SetBinLabel(i + 1, _cut_descriptions[i].c_str());
+			h.SetBinContent(i + 1, _nsel[i]);
+		}
+		h.Write();
+	}
+
+	//Add the time in ms of a previous run, e.g. before a checkpoint.
+	void add_duration(int ms) {
+		_previous_duration += ms;
+	}
+
 	//Return the time in ms since the first event was processed.
 	int get_duration() {
 		if (not started)
-			return 0;
-		return std::chrono::duration_cast < std::chrono::milliseconds
+			return _previous_duration;
+		return _previous_duration + std::chrono::duration_cast < std::chrono::milliseconds
 				> (std::chrono::steady_clock::now() - start_time).count();
 	}
 
@@ -114,6 +138,7 @@ private:
 	std::vector<std::string> _cut_descriptions;
 	std::vector<unsigned int> _nsel;
 	bool started;
+	int _previous_duration;
 	std::chrono::time_point<std::chrono::steady_clock> start_time;
 };
 std::ostream& operator<<(std::ostream& os, const CutFlow& obj) {
@@ -191,50 +216,80 @@ std::map<std::string, TH1F*> create_histograms(unsigned int njets) {
 	return h1;
 }
 
-inline std::vector<Jet*> get_jets_loose(Analysis* analysis) {
-	// Jets - std::shared_ptr< Collection<Jet> >
-	auto slimmedJets = analysis->collection < Jet > ("Jets");
-	std::vector<Jet*> selectedJets;
-	for (int j = 0; j < slimmedJets->size(); ++j) {
-		Jet* jet = &slimmedJets->at(j);
-		if (jet->idLoose())
-			selectedJets.push_back(jet);
+//Histograms of the events in each systematic variation of the jets, as
+//the nominal ones and tagged with the name of the variation.
+void create_variation_histograms(std::map<std::string, TH1F*>& h1,
+		unsigned int njets, const JetVariations& variations) {
+	auto book = [&h1](const std::string& name, int nbins, double min,
+			double max) {
+		h1[name] = new TH1F(name.c_str(), "", nbins, min, max);
+	};
+	for (size_t v = 0; v < variations.size(); ++v) {
+		const std::string tag = "_" + variations.name(v);
+		book("totalSelected" + tag, 1, 0., 1.);
+		book("n_csv" + tag, 30, 0, 30);
+		book("n_ptmin20_csv" + tag, 30, 0, 30);
+		book("n_ptmin30_csv" + tag, 30, 0, 30);
+		for (unsigned int i = 0; i < njets; ++i) {
+			if (i < 2) {
+				book(Form("pt_%i", i) + tag, 100, 0, 1000);
+				book(Form("pt_%i_csv", i) + tag, 100, 0, 1000);
+			} else {
+				book(Form("pt_%i", i) + tag, 50, 0, 200);
+				book(Form("pt_%i_csv", i) + tag, 50, 0, 200);
+			}
+			book(Form("eta_%i_csv", i) + tag, 100, -5, 5);
+			book(Form("phi_%i_csv", i) + tag, 100, -4, 4);
+			book(Form("btag_%i_csv", i) + tag, 100, 0, 1);
+		}
+		book("m12" + tag, 50, 0, 1000);
+		book("m12_csv" + tag, 50, 0, 1000);
 	}
-	return selectedJets;
 }
 
-inline bool select_kinematic(const std::vector<Jet*>& jets, unsigned int njets,
-		const float* ptmin, const float* etamax) {
+inline CollectionView<Jet> get_jets_loose(Analysis* analysis,
+		const CollectionHandle<Jet>& jets) {
+	// Jets - std::shared_ptr< Collection<Jet> >, viewed without copying
+	auto slimmedJets = analysis->collection(jets);
+	return slimmedJets->view().filter(
+			[](const Jet& jet) {return jet.idLoose();});
+}
+
+//The pts of the jets are given if they are not those of the jets, e.g. in
+//a systematic variation.
+inline bool select_kinematic(const CollectionView<Jet>& jets, unsigned int njets,
+		const float* ptmin, const float* etamax, const float* pts = nullptr) {
 	for (unsigned int j = 0; j < njets; ++j) {
-		Jet* jet = jets[j];
-		if (jet->pt() < ptmin[j] || fabs(jet->eta()) > etamax[j])
+		const Jet& jet = jets[j];
+		const float pt = pts ? pts[j] : jet.pt();
+		if (pt < ptmin[j] || fabs(jet.eta()) > etamax[j])
 			return false;
 	}
 	return true;
 }
 
-inline bool select_deltaR(const std::vector<Jet*>& jets, unsigned int njets,
+inline bool select_deltaR(const CollectionView<Jet>& jets, unsigned int njets,
 		float dRmin) {
-	for (unsigned int j1 = 0; j1 < njets - 1; ++j1) {
-		const Jet& jet1 = *jets[j1];
-		for (unsigned int j2 = j1 + 1; j2 < njets; ++j2) {
-			const Jet& jet2 = *jets[j2];
-			if (jet1.deltaR(jet2) < dRmin)
+	// all pairs of the leading jets, compared in deltaR^2
+	const float dR2min = dRmin * dRmin;
+	njets = std::min(njets, (unsigned int) jets.size());
+	for (unsigned int i = 0; i + 1 < njets; ++i)
+		for (unsigned int j = i + 1; j < njets; ++j)
+			if (deltaR2(jets[i].eta(), jets[i].phi(), jets[j].eta(),
+					jets[j].phi()) < dR2min)
 				return false;
-		}
-	}
 	return true;
 }
 
-inline bool select_btag(const std::vector<Jet*>& jets, unsigned int njets,
+inline bool select_btag(const CollectionView<Jet>& jets, unsigned int njets,
 		bool deepb, bool isbbbb, const float* btagmin, float nonbtag) {
 	for (unsigned int j = 0; j < njets; ++j) {
-		Jet* jet = jets[j];
+		const Jet& jet = jets[j];
 		float btag;
 		if (deepb)
-			btag = jet->btag("btag_deepb") + jet->btag("btag_deepbb");
+			btag = jet.btag("btag_deepb") + jet.btag("btag_deepbb");
 		else
-			btag = jet->btag();
+			btag = jet.btag();
 		if ((j < njets - 1 and btag < btagmin[j])
 				or (j == njets - 1 and isbbbb and btag < btagmin[j])
 				or (j == njets - 1 and not isbbbb and btag > nonbtag)) {
@@ -244,14 +299,14 @@ inline bool select_btag(const std::vector<Jet*>& jets, unsigned int njets,
 	return true;
 }
 
-inline unsigned int get_num_matched(const std::vector<Jet*>& jets,
+inline unsigned int get_num_matched(const CollectionView<Jet>& jets,
 		unsigned int njets, const std::vector<std::string>& triggerObjects) {
 	unsigned int n;
 	for (unsigned int j = 0; j < njets; ++j) {
-		Jet* jet = jets[j];
+		const Jet& jet = jets[j];
 		n = 0;
 		for (const auto& triggerObject : triggerObjects) {
-			if (not jet->matched(triggerObject))
+			if (not jet.matched(triggerObject))
 				return n;
 			++n;
 		}
@@ -263,9 +318,16 @@ int main(int argc, char* argv[]) {
 	unsigned int njets;
 	std::string config_file, input_list, output_file, json_file;
 	std::string jetTreePath, triggerResultsPath, triggerBranch;
+	std::string shard;
+	std::string checkpoint_file;
+	int checkpoint_events, checkpoint_seconds;
+	int monitor_seconds;
 	std::vector < std::string > triggerObjects;
 	bool isbbbb, isMC;
 	bool deepb;
+	bool pipeline;
+	bool staged;
+	bool variations;
 	float ptmin[MAX_JETS];
 	float btagmin[MAX_JETS];
 	float nonbtag;
@@ -279,7 +341,23 @@ int main(int argc, char* argv[]) {
 		po::options_description generic("Generic options");
 		generic.add_options()("help,h", "Produce help message.")("config,c",
 				po::value < std::string > (&config_file),
-				"Name of a file of a configuration.");
+				"Name of a file of a configuration.")("shard",
+				po::value < std::string > (&shard),
+				"Process only the k-th of N parts of the events, given as k/N"
+						" (k = 0..N-1). Default from the environment variable"
+						" ANALYSIS_SHARD, as set by the batch scripts.")("checkpoint",
+				po::value < std::string > (&checkpoint_file),
+				"File to which the histograms and cut flow are saved periodically."
+						" A rerun with the same configuration resumes from it.")(
+				"checkpointevents",
+				po::value<int>(&checkpoint_events)->default_value(1000000),
+				"Number of events between checkpoints (0: not used).")(
+				"checkpointseconds",
+				po::value<int>(&checkpoint_seconds)->default_value(600),
+				"Seconds between checkpoints (0: not used).")("monitor",
+				po::value<int>(&monitor_seconds)->default_value(0),
+				"Print the throughput and ETA every given number of seconds and"
+						" the event loop counters at the end (0: not used).");
 
 		// Declare a group of options that will be 
 		// allowed both on command line and in
@@ -307,7 +385,15 @@ int main(int argc, char* argv[]) {
 				po::value<unsigned int>(&njets)->default_value(MAX_JETS),
 				"Minimum number of jets")("deepb",
 				"Use DeepFlavour btag discriminator value instead"
-						" of the normal btag value.");
+						" of the normal btag value.")("pipeline",
+				"Read the next event in a background thread while the current"
+						" one is analysed.")("staged",
+				"Read the jets and trigger objects only for events passing the"
+						" JSON and trigger selection.")("variations",
+				"Also select the events with the JER smeared jets (nominal)"
+						" and their JER and JEC up/down variations (MC only),"
+						" with a cut flow and histograms tagged with the"
+						" variation.");
 		for (unsigned int i = 0; i < MAX_JETS; ++i) {
 			std::string help_text = "Minimum pt of the " + int_to_count(i + 1)
 					+ " leading jet.";
@@ -391,10 +477,17 @@ int main(int argc, char* argv[]) {
 			}
 		}
 
+		//The shard of a batch job is given in the environment
+		if (shard.empty() and std::getenv("ANALYSIS_SHARD"))
+			shard = std::getenv("ANALYSIS_SHARD");
+
 		//Set booleans if particular arguments are supplied
 		isMC = vm.count("json") == 0;
 		isbbbb = vm.count("nonbtag") == 0;
 		deepb = vm.count("deepb") != 0;
+		pipeline = vm.count("pipeline") != 0;
+		staged = vm.count("staged") != 0;
+		variations = isMC and vm.count("variations") != 0;
 
 		//Validate configuration
 		if (not (njets <= MAX_JETS)) {
@@ -497,14 +590,29 @@ int main(int argc, char* argv[]) {
 
 	TH1::SetDefaultSumw2(); // proper treatment of errors when scaling histograms
 	Analysis analysis(input_list);
-	analysis.addTree < Jet > ("Jets", jetTreePath);
+	// handles for the access to the collections in the event loop
+	const CollectionHandle<Jet> jets = analysis.addTree < Jet > ("Jets", jetTreePath);
 	analysis.triggerResults(triggerResultsPath);
+	std::vector<CollectionHandle<TriggerObject> > triggerObjectHandles;
 	for (const auto& obj : triggerObjects)
-		analysis.addTree < TriggerObject > (obj, obj.c_str());
+		triggerObjectHandles.push_back(
+				analysis.addTree < TriggerObject > (obj, obj.c_str()));
 	if (not isMC)
 		analysis.processJsonFile(json_file);
+	if (not shard.empty())
+		analysis.setShard(shard);
+	if (pipeline)
+		analysis.pipeline(true);
+	if (staged)
+		analysis.stagedReading(true);
+	if (monitor_seconds > 0)
+		analysis.monitor(monitor_seconds);
 
 	std::map<std::string, TH1F*> h1 = create_histograms(njets);
+	JetVariations variationNames;
+	variationNames.addJerJec();
+	if (variations)
+		create_variation_histograms(h1, njets, variationNames);
 
 	//Make a list of trigger object names without preceding path
 	std::vector < std::string > trigNames;
@@ -519,8 +627,38 @@ int main(int argc, char* argv[]) {
 					"btagged (" + std::string(njets - 1, 'b')
 							+ (isbbbb ? "b)" : "nb)"), "Matched to online j1;j2" });
 	CutFlow cf_trig(trigNames, "Trigger Objects");
+	//The cut flows of the variations, from the events with enough jets
+	std::vector<CutFlow> cf_variations;
+	if (variations)
+		for (size_t v = 0; v < variationNames.size(); ++v)
+			cf_variations.push_back(
+					CutFlow(
+							std::vector<std::string>(
+									cf.get_descriptions().begin() + 2,
+									cf.get_descriptions().end()),
+							"Cut Flow " + variationNames.name(v)));
+
+	if (not checkpoint_file.empty()) {
+		//The configuration file and the arguments define the job, so that
+		//only the same job resumes from the checkpoint.
+		std::ifstream config_file_s(config_file.c_str());
+		std::string config((std::istreambuf_iterator<char>(config_file_s)),
+				std::istreambuf_iterator<char>());
+		for (int i = 1; i < argc; ++i)
+			config += std::string(" ") + argv[i];
+		for (const auto& ih1 : h1)
+			analysis.checkpointHistogram(ih1.second);
+		analysis.checkpointCounters("cf", cf.get_nsel());
+		analysis.checkpointCounters("cf_trig", cf_trig.get_nsel());
+		for (size_t v = 0; v < cf_variations.size(); ++v)
+			analysis.checkpointCounters("cf_" + variationNames.name(v),
+					cf_variations[v].get_nsel());
+		if (analysis.checkpoint(checkpoint_file, checkpoint_events,
+				checkpoint_seconds, config))
+			cf.add_duration(1000 * analysis.checkpointElapsed());
+	}
 
-	std::cout << "This analysis has " << analysis.size() << " events."
+	std::cout << "This analysis has " << analysis.rangeSize() << " events."
 			<< std::endl;
 
 	for (int i = 0; i < analysis.size(); ++i) {
@@ -540,22 +678,91 @@ int main(int argc, char* argv[]) {
 			continue;
 
 		//Require minimum of njets loose jets
-		std::vector<Jet*> selectedJets = get_jets_loose(&analysis);
+		CollectionView<Jet> selectedJets = get_jets_loose(&analysis, jets);
 		if (cf.do_cut(selectedJets.size() < njets))
 			continue;
+		// Leading njets in pt, the others are not ordered
+		selectedJets.partialSortByPt(njets);
+		const size_t nptmin20 = selectedJets.countPtMin(20.);
+		// Higgs candidate from the two leading jets
+		const CompositeCandidate higgs(selectedJets, 2);
+
+		// Match offline to online, once for the nominal and the variations
+		bool matched = false;
+
+		// Systematic variations, selected from the same jets in this pass
+		// with the selection of the nominal jets, each with its cut flow.
+		// Only pt and energy change; the leading jets are those of the
+		// varied pt.
+		if (variations) {
+			for (const auto& triggerObjectHandle : triggerObjectHandles)
+				analysis.match(jets, triggerObjectHandle, 0.5);
+			matched = true;
+			JetVariations jetVariations(selectedJets,
+					analysis.randomStream(jets.name));
+			jetVariations.addJerJec();
+			for (size_t v = 0; v < jetVariations.size(); ++v) {
+				CutFlow& cfv = cf_variations[v];
+				cfv.next_event();
+				cfv.do_cut(false);
+				const std::string tag = "_" + jetVariations.name(v);
+				const std::vector<unsigned int>& order = jetVariations.ptOrder(v);
+				const CollectionView<Jet> leadingJets = jetVariations.leading(v,
+						njets);
+				float pts[MAX_JETS];
+				for (unsigned int j = 0; j < njets; ++j) {
+					pts[j] = jetVariations.pt(v, order[j]);
+					h1[Form("pt_%i", j) + tag]->Fill(pts[j]);
+				}
+				const float m12 = jetVariations.m(v, order[0], order[1]);
+				h1["m12" + tag]->Fill(m12);
+
+				if (cfv.do_cut(
+						not select_kinematic(leadingJets, njets, ptmin, etamax,
+								pts)))
+					continue;
+				if (cfv.do_cut(not select_deltaR(leadingJets, njets, dRmin)))
+					continue;
+				if (cfv.do_cut(
+						fabs(leadingJets[0].eta() - leadingJets[1].eta())
+								> detamax))
+					continue;
+				if (cfv.do_cut(
+						not select_btag(leadingJets, njets, deepb, isbbbb,
+								btagmin, nonbtag)))
+					continue;
+				if (cfv.do_cut(
+						get_num_matched(leadingJets, 2, triggerObjects)
+								!= triggerObjects.size()))
+					continue;
+
+				h1["totalSelected" + tag]->Fill(0.5);
+				h1["n_csv" + tag]->Fill(selectedJets.size());
+				h1["n_ptmin20_csv" + tag]->Fill(
+						jetVariations.countPtMin(v, 20.));
+				h1["n_ptmin30_csv" + tag]->Fill(
+						jetVariations.countPtMin(v, 30.));
+				for (unsigned int j = 0; j < njets; ++j) {
+					const Jet& jet = leadingJets[j];
+					h1[Form("pt_%i_csv", j) + tag]->Fill(pts[j]);
+					h1[Form("eta_%i_csv", j) + tag]->Fill(jet.eta());
+					h1[Form("phi_%i_csv", j) + tag]->Fill(jet.phi());
+					h1[Form("btag_%i_csv", j) + tag]->Fill(jet.btag());
+				}
+				h1["m12_csv" + tag]->Fill(m12);
+			}
+		}
 
 		//Fill histrograms before further cuts
 		h1["n"]->Fill(selectedJets.size());
-		h1["n_ptmin20"]->Fill(
-				std::count_if(selectedJets.begin(), selectedJets.end(),
-						[](Jet* jet) {return jet->pt() >= 20.;}));
-		h1["m12"]->Fill((selectedJets[0]->p4() + selectedJets[1]->p4()).M());
+		h1["n_ptmin20"]->Fill(nptmin20);
+		h1["m12"]->Fill(higgs.m());
 		for (unsigned int j = 0; j < njets; ++j) {
-			Jet* jet = selectedJets[j];
-			h1[Form("pt_%i", j)]->Fill(jet->pt());
-			h1[Form("eta_%i", j)]->Fill(jet->eta());
-			h1[Form("phi_%i", j)]->Fill(jet->phi());
-			h1[Form("btag_%i", j)]->Fill(jet->btag());
+			const Jet& jet = selectedJets[j];
+			h1[Form("pt_%i", j)]->Fill(jet.pt());
+			h1[Form("eta_%i", j)]->Fill(jet.eta());
+			h1[Form("phi_%i", j)]->Fill(jet.phi());
+			h1[Form("btag_%i", j)]->Fill(jet.btag());
 		}
 
 		// Kinematic selection
@@ -568,8 +775,7 @@ int main(int argc, char* argv[]) {
 
 		// Delta eta selection - 2 leading jets
 		if (cf.do_cut(
-				fabs(selectedJets[0]->eta() - selectedJets[1]->eta())
-						> detamax))
+				fabs(selectedJets[0].eta() - selectedJets[1].eta()) > detamax))
 			continue;
 
 		// Btag selction
@@ -579,7 +785,9 @@ int main(int argc, char* argv[]) {
 			continue;
 
 		// Match offline to online
-		analysis.match<Jet, TriggerObject>("Jets", triggerObjects, 0.5);
+		if (not matched)
+			for (const auto& triggerObjectHandle : triggerObjectHandles)
+				analysis.match(jets, triggerObjectHandle, 0.5);
 		// Are the TWO leading jets matched?
 		if (cf.do_cut(
 				cf_trig.do_cut_all(
@@ -589,34 +797,40 @@ int main(int argc, char* argv[]) {
 		// Fill histograms of passed btagging selection
 		h1["totalSelected"]->Fill(0.5);
 		h1["n_csv"]->Fill(selectedJets.size());
-		h1["n_ptmin20_csv"]->Fill(
-				std::count_if(selectedJets.begin(), selectedJets.end(),
-						[](Jet* jet) {return jet->pt() >= 20.;}));
-		h1["n_ptmin30_csv"]->Fill(
-				std::count_if(selectedJets.begin(), selectedJets.end(),
-						[](Jet* jet) {return jet->pt() >= 30.;}));
+		h1["n_ptmin20_csv"]->Fill(nptmin20);
+		h1["n_ptmin30_csv"]->Fill(selectedJets.countPtMin(30.));
 		for (unsigned int j = 0; j < njets; ++j) {
-			Jet* jet = selectedJets[j];
-			h1[Form("pt_%i_csv", j)]->Fill(jet->pt());
-			h1[Form("eta_%i_csv", j)]->Fill(jet->eta());
-			h1[Form("phi_%i_csv", j)]->Fill(jet->phi());
-			h1[Form("btag_%i_csv", j)]->Fill(jet->btag());
+			const Jet& jet = selectedJets[j];
+			h1[Form("pt_%i_csv", j)]->Fill(jet.pt());
+			h1[Form("eta_%i_csv", j)]->Fill(jet.eta());
+			h1[Form("phi_%i_csv", j)]->Fill(jet.phi());
+			h1[Form("btag_%i_csv", j)]->Fill(jet.btag());
 		}
-		h1["m12_csv"]->Fill(
-				(selectedJets[0]->p4() + selectedJets[1]->p4()).M());
+		h1["m12_csv"]->Fill(higgs.m());
 	}
 
 	//Print statistics
 	std::cout << std::endl;
 	std::cout << "Analysis took " << cf.get_duration() << " ms." << std::endl;
+	if (monitor_seconds > 0)
+		analysis.listMonitor();
 
 	TFile hout(output_file.c_str(), "recreate");
 	for (const auto& ih1 : h1) {
 		ih1.second->Write();
 	}
+	cf.write("cutflow");
+	cf_trig.write("cutflow_trig");
+	for (size_t v = 0; v < cf_variations.size(); ++v)
+		cf_variations[v].write("cutflow_" + variationNames.name(v));
+	//All events of the job, also those before a resume from a checkpoint.
+	TParameter<Long64_t> nevents("events", analysis.rangeSize());
+	nevents.Write();
 	hout.Close();
 
 	std::cout << cf << std::endl << std::endl << cf_trig << std::endl;
+	for (const auto& cfv : cf_variations)
+		std::cout << std::endl << cfv << std::endl;
 
 	// Efficiency
 	//TODO: Efficiency and JSON?
@@ -0,0 +1,363 @@
+// Microbenchmarks of the hot paths of Analysis/Core.
+//
+// Each benchmark prints one line with its name, the number of calls per
+// repetition, the time per call (the fastest of several repetitions) and a
+// checksum of the results, so that outputs of different releases can be diffed.
+// Benchmarks on synthetic objects always run; the ones reading trees run
+// when an input list is given, the others when their inputs are given.
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TRandom.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//Repetitions of each benchmark, the fastest one is reported.
+const int REPETITIONS = 5;
+
+void print_header() {
+	std::cout << std::setw(45) << std::left << "benchmark" << std::setw(10)
+			<< std::right << "calls" << std::setw(14) << "ns/call"
+			<< std::setw(14) << "checksum" << std::endl;
+}
+
+void print_result(const std::string& name, unsigned int n, double ns,
+		unsigned long checksum) {
+	std::cout << std::setw(45) << std::left << name << std::setw(10)
+			<< std::right << n << std::setw(14) << std::fixed
+			<< std::setprecision(1) << ns << std::setw(14) << checksum
+			<< std::endl;
+}
+
+void print_skipped(const std::string& name, const std::string& reason) {
+	std::cout << std::setw(45) << std::left << name << "skipped (" << reason
+			<< ")" << std::endl;
+}
+
+//Time n calls of f(i), which returns a number added to the checksum.
+template<class F>
+void bench(const std::string& name, unsigned int n, F f) {
+	double best = 0;
+	unsigned long checksum = 0;
+	for (int r = 0; r < REPETITIONS; ++r) {
+		checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < n; ++i)
+			checksum += f(i);
+		double ns = std::chrono::duration<double, std::nano>(
+				std::chrono::steady_clock::now() - start).count() / n;
+		if (r == 0 or ns < best)
+			best = ns;
+	}
+	print_result(name, n, best, checksum);
+}
+
+//Synthetic jets with realistic kinematics, id variables and resolutions.
+std::vector<Jet> make_jets(std::mt19937& gen, unsigned int n) {
+	std::exponential_distribution<float> pt(1. / 50.);
+	std::uniform_real_distribution<float> eta(-2.5, 2.5);
+	std::uniform_real_distribution<float> phi(-M_PI, M_PI);
+	std::uniform_real_distribution<float> frac(0., 1.);
+	std::uniform_int_distribution<int> flav(0, 5);
+	std::vector<Jet> jets;
+	for (unsigned int j = 0; j < n; ++j) {
+		float jpt = 20. + pt(gen);
+		float jeta = eta(gen);
+		Jet jet(jpt, jeta, phi(gen), jpt * std::cosh(jeta));
+		jet.btag(frac(gen));
+		jet.flavour("Hadron", flav(gen));
+		jet.JerResolution(0.1);
+		jet.JerSf(1.1);
+		jet.JerSfUp(1.2);
+		jet.JerSfDown(1.0);
+		jets.push_back(jet);
+	}
+	return jets;
+}
+
+//Synthetic candidates, e.g. trigger objects or generator jets.
+std::vector<Candidate> make_candidates(std::mt19937& gen, unsigned int n) {
+	std::exponential_distribution<float> pt(1. / 50.);
+	std::uniform_real_distribution<float> eta(-2.5, 2.5);
+	std::uniform_real_distribution<float> phi(-M_PI, M_PI);
+	std::vector<Candidate> cands;
+	for (unsigned int j = 0; j < n; ++j) {
+		float cpt = 20. + pt(gen);
+		float ceta = eta(gen);
+		cands.push_back(Candidate(cpt, ceta, phi(gen), cpt * std::cosh(ceta)));
+	}
+	return cands;
+}
+
+//Synthetic generator particles, part of them partons of the pythia8 shower.
+std::shared_ptr<Collection<GenParticle> > make_genparticles(std::mt19937& gen,
+		unsigned int n) {
+	std::exponential_distribution<float> pt(1. / 20.);
+	std::uniform_real_distribution<float> eta(-5., 5.);
+	std::uniform_real_distribution<float> phi(-M_PI, M_PI);
+	std::uniform_int_distribution<int> pdg(1, 22);
+	std::uniform_int_distribution<int> status(70, 73);
+	std::vector<GenParticle> particles;
+	for (unsigned int j = 0; j < n; ++j) {
+		float ppt = pt(gen);
+		float peta = eta(gen);
+		GenParticle p(ppt, peta, phi(gen), ppt * std::cosh(peta), 0);
+		int id = pdg(gen);
+		p.pdgId(id > 6 ? 21 : id);
+		p.status(status(gen));
+		particles.push_back(p);
+	}
+	return std::shared_ptr<Collection<GenParticle> >(
+			new Collection<GenParticle>(particles, "GenParticles"));
+}
+
+//Analysis with the run and lumi section set directly, so that lookups by
+//them can be timed without reading the events.
+class BenchmarkAnalysis: public Analysis {
+public:
+	BenchmarkAnalysis(const std::string& inputFilelist) :
+			Analysis(inputFilelist) {
+	}
+	void runLumi(int run, int lumi) {
+		run_ = run;
+		lumi_ = lumi;
+	}
+};
+
+//Sum of the pt of the jets in units of MeV, as checksum of the smearing.
+unsigned long sum_pt(Collection<Jet>& jets) {
+	unsigned long sum = 0;
+	for (int j = 0; j < jets.size(); ++j)
+		sum += (unsigned long) (1000. * jets.at(j).pt());
+	return sum;
+}
+
+//PhysicsObjectTree<Object>::collection() timed without reading the entries.
+template<class Object>
+void bench_tree(Analysis& analysis, const std::string& type,
+		const std::string& path, int nevents) {
+	std::string name = "PhysicsObjectTree<" + type + ">::collection";
+	auto handle = analysis.addTree < Object > (type, path);
+	auto tree = analysis.tree(handle);
+	if (not tree) {
+		print_skipped(name, "no tree " + path);
+		return;
+	}
+	int n = std::min(nevents, analysis.size());
+	double best = 0;
+	unsigned long checksum = 0;
+	for (int r = 0; r < REPETITIONS; ++r) {
+		checksum = 0;
+		double ns = 0;
+		for (int i = 0; i < n; ++i) {
+			analysis.event(i, false);
+			auto start = std::chrono::steady_clock::now();
+			checksum += tree->collection().size();
+			ns += std::chrono::duration<double, std::nano>(
+					std::chrono::steady_clock::now() - start).count();
+		}
+		if (r == 0 or ns / n < best)
+			best = ns / n;
+	}
+	print_result(name, n, best, checksum);
+}
+
+int main(int argc, char* argv[]) {
+	std::string input_list, json_file, btageff_file, triggerResultsPath,
+			triggerBranch;
+	std::vector<std::string> trees;
+	int nevents;
+
+	try {
+		po::options_description generic("Allowed options");
+		generic.add_options()("help,h", "Produce help message.")("input-list",
+				po::value < std::string > (&input_list),
+				"Input file list for the benchmarks reading trees.")("tree",
+				po::value < std::vector < std::string >> (&trees)->composing(),
+				"Tree to benchmark as Type:path, e.g. "
+						"Jet:MssmHbb/Events/slimmedJetsPuppi (repeatable).")(
+				"trigrespath", po::value < std::string > (&triggerResultsPath),
+				"Path to the trigger results tree.")("trigbranch",
+				po::value < std::string > (&triggerBranch),
+				"Trigger to look up in the trigger results.")("json",
+				po::value < std::string > (&json_file),
+				"JSON file of good lumi sections.")("btageff",
+				po::value < std::string > (&btageff_file),
+				"File with the btag efficiencies.")("nevents",
+				po::value<int>(&nevents)->default_value(10000),
+				"Number of events for the benchmarks reading trees.");
+
+		po::variables_map vm;
+		po::store(po::parse_command_line(argc, argv, generic), vm);
+		if (vm.count("help")) {
+			std::cout << generic << std::endl;
+			return 0;
+		}
+		po::notify(vm);
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	std::mt19937 gen(12345);
+	gRandom->SetSeed(12345);
+
+	print_header();
+
+	// Collections
+	std::vector<Jet> jets = make_jets(gen, 10);
+	bench("Collection<Jet>::Collection (n=10)", 100000,
+			[&jets](unsigned int) {
+				Collection<Jet> c(jets, "Jets");
+				return (unsigned long) c.size();
+			});
+	Collection<Jet> jetCollection(jets, "Jets");
+	bench("Collection<Jet> copy (n=10)", 100000,
+			[&jetCollection](unsigned int) {
+				Collection<Jet> c(jetCollection);
+				return (unsigned long) c.size();
+			});
+
+	// Matching
+	unsigned int sizes[] = { 4, 10, 30, 100 };
+	for (auto n : sizes) {
+		std::vector<Jet> njets = make_jets(gen, n);
+		std::vector<Candidate> cands = make_candidates(gen, n);
+		bench("Candidate::matchTo (" + std::to_string(n) + "x"
+				+ std::to_string(n) + ")", 100000 / n,
+				[&njets, &cands](unsigned int) {
+					unsigned long matched = 0;
+					for (auto & jet : njets)
+						matched += jet.matchTo(CandidateView(cands), "TriggerObjects", 0.5);
+					return matched;
+				});
+	}
+
+	// Partons, including the construction of the jets they are added to
+	auto genParticles = make_genparticles(gen, 200);
+	bench("Collection<Jet>::associatePartons (10x200)", 1000,
+			[&jets, &genParticles](unsigned int) {
+				Collection<Jet> c(jets, "Jets");
+				c.associatePartons(genParticles, 0.4, 1., true);
+				unsigned long n = 0;
+				for (int j = 0; j < c.size(); ++j)
+					n += c.at(j).partons().size();
+				return n;
+			});
+
+	// Jet id
+	std::uniform_real_distribution<float> frac(0., 1.);
+	std::vector<std::vector<float> > idVars;
+	for (int i = 0; i < 1000; ++i)
+		idVars.push_back( { frac(gen), frac(gen), float(int(frac(gen) * 10)),
+				frac(gen), frac(gen), float(int(frac(gen) * 20)), frac(gen) });
+	Jet idJet = jets[0];
+	bench("Jet::id", 1000000, [&idJet, &idVars](unsigned int i) {
+		const std::vector<float>& v = idVars[i % idVars.size()];
+		idJet.id(v[0], v[1], v[2], v[3], v[4], v[5], v[6]);
+		return (unsigned long) idJet.idLoose() + idJet.idTight();
+	});
+
+	// Smearing to matched generator jets, each call smears a copy of the same
+	// jets, as smearing them again and again in place runs off to inf or 0
+	Collection<Jet> genJets(make_jets(gen, 10), "GenJets");
+	Collection<Jet> matchedJets(jets, "Jets");
+	matchedJets.matchTo(genJets.candidates(), genJets.name(), 0.5);
+	bench("Collection<Jet>::smearTo, with the copy (n=10)", 100000,
+			[&matchedJets, &genJets](unsigned int) {
+				Collection<Jet> smearJets(matchedJets);
+				smearJets.smearTo(genJets, 0);
+				return sum_pt(smearJets);
+			});
+	bench("Collection<Jet>::smearTo RandomStream, with the copy (n=10)", 100000,
+			[&matchedJets, &genJets](unsigned int i) {
+				Collection<Jet> smearJets(matchedJets);
+				smearJets.smearTo(genJets, RandomStream(1, 1, i, "Jets"), 0);
+				return sum_pt(smearJets);
+			});
+
+	// Benchmarks needing input files
+	if (input_list.empty()) {
+		print_skipped("PhysicsObjectTree<T>::collection", "no input list");
+		print_skipped("Analysis::triggerResult", "no input list");
+		print_skipped("Analysis::selectJson", "no input list");
+		print_skipped("Analysis::btagEfficiency", "no input list");
+		return 0;
+	}
+	BenchmarkAnalysis analysis(input_list);
+
+	for (const auto& tree : trees) {
+		std::string type = tree.substr(0, tree.find(':'));
+		std::string path = tree.substr(tree.find(':') + 1);
+		if (type == "Jet")
+			bench_tree < Jet > (analysis, type, path, nevents);
+		else if (type == "Muon")
+			bench_tree < Muon > (analysis, type, path, nevents);
+		else if (type == "GenJet")
+			bench_tree < GenJet > (analysis, type, path, nevents);
+		else if (type == "MET")
+			bench_tree < MET > (analysis, type, path, nevents);
+		else if (type == "Vertex")
+			bench_tree < Vertex > (analysis, type, path, nevents);
+		else if (type == "TriggerObject")
+			bench_tree < TriggerObject > (analysis, type, path, nevents);
+		else if (type == "GenParticle")
+			bench_tree < GenParticle > (analysis, type, path, nevents);
+		else if (type == "Candidate")
+			bench_tree < Candidate > (analysis, type, path, nevents);
+		else if (type == "JetTag")
+			bench_tree < JetTag > (analysis, type, path, nevents);
+		else
+			print_skipped("PhysicsObjectTree<" + type + ">::collection",
+					"unknown type");
+	}
+
+	if (not triggerResultsPath.empty() and not triggerBranch.empty()) {
+		analysis.triggerResults(triggerResultsPath);
+		analysis.event(0, false);
+		bench("Analysis::triggerResult", 1000000,
+				[&analysis, &triggerBranch](unsigned int) {
+					return (unsigned long) analysis.triggerResult(triggerBranch);
+				});
+	} else
+		print_skipped("Analysis::triggerResult", "no trigrespath/trigbranch");
+
+	if (not json_file.empty()) {
+		analysis.processJsonFile(json_file);
+		// the run and lumi sections are read before, only the lookup is timed
+		int n = std::min(nevents, analysis.size());
+		std::vector<std::pair<int, int> > runLumis;
+		for (int i = 0; i < n; ++i) {
+			analysis.event(i, false);
+			runLumis.push_back(std::make_pair(analysis.run(), analysis.lumiSection()));
+		}
+		bench("Analysis::selectJson", n, [&analysis, &runLumis](unsigned int i) {
+			analysis.runLumi(runLumis[i].first, runLumis[i].second);
+			return (unsigned long) analysis.selectJson();
+		});
+	} else
+		print_skipped("Analysis::selectJson", "no json");
+
+	if (not btageff_file.empty()) {
+		analysis.addBtagEfficiencies(btageff_file);
+		bench("Analysis::btagEfficiency", 1000000,
+				[&analysis, &jets](unsigned int i) {
+					float eff = analysis.btagEfficiency(jets[i % jets.size()]);
+					return (unsigned long) (eff * 1000);
+				});
+	} else
+		print_skipped("Analysis::btagEfficiency", "no btageff");
+
+	return 0;
+}
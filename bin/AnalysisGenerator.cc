@@ -36,7 +36,7 @@ int main(int argc, char * argv[])
    Analysis analysis(inputList);
    
    // Physics Objects Collections
-   analysis.addTree<GenParticle> ("GenParticles","MssmHbb/Events/prunedGenParticles");
+   auto genParticlesHandle = analysis.addTree<GenParticle> ("GenParticles","MssmHbb/Events/prunedGenParticles");
    analysis.addTree<GenJet> ("GenJets","MssmHbb/Events/slimmedGenJets");
    analysis.addTree<Jet> ("Jets","MssmHbb/Events/slimmedJetsReapplyJEC");
 
@@ -62,32 +62,28 @@ int main(int argc, char * argv[])
       // using delta_R matching. Maybe maybe some delta_pt/pt... but that's not done here.
       
       
-      auto genParticles = analysis.collection<GenParticle>("GenParticles");
+      // The index gives the particles of a pdgId and status without scanning the collection
+      const GenParticleIndex & genParticles = analysis.genParticleIndex(genParticlesHandle);
       GenParticle bquark;
       GenParticle bbarquark;
       std::vector<GenParticle> muons;
       
-      for ( int j = 0 ; j < genParticles->size() ; ++j )
+      for ( auto & gp : genParticles.withPdg(13).status(1,1) )
+         muons.push_back(gp);
+ 
+      if ( isSignal_ )
       {
-         GenParticle gp = genParticles->at(j);
-         if ( abs(gp.pdgId()) == 13 && gp.status() == 1 ) 
+         for ( auto & gp : genParticles.withPdg(36).status(61) )
          {
-            muons.push_back(gp);
+            if ( gp.pdgId() != 36 ) continue;
+            h1_["h_hig_pt"]  -> Fill(gp.pt() );
+            h1_["h_hig_eta"] -> Fill(gp.eta());
+            h1_["h_hig_phi"] -> Fill(gp.phi());
          }
- 
-         if ( isSignal_ )
+         for ( auto & gp : genParticles.higgsDaughters() )
          {
-            if ( gp.pdgId() == 36 && gp.status() > 60 )
-            {
-               h1_["h_hig_pt"]  -> Fill(gp.pt() );
-               h1_["h_hig_eta"] -> Fill(gp.eta());
-               h1_["h_hig_phi"] -> Fill(gp.phi());
-            }
-            if ( fabs(gp.pdgId()) == 5 && gp.higgsDaughter() ) 
-            {
-               if ( gp.pdgId() > 0 )  bquark = gp;
-               if ( gp.pdgId() < 0 )  bbarquark = gp;
-            }
+            if ( gp->pdgId() ==  5 )  bquark = *gp;
+            if ( gp->pdgId() == -5 )  bbarquark = *gp;
          }
       }
       
@@ -1,6 +1,7 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <cstdlib>
 
 #include "TFile.h" 
 #include "TFileCollection.h"
@@ -22,14 +23,19 @@ int main(int argc, char * argv[])
    // Input files list
    std::string inputList = "rootFileList.txt";
    Analysis analysis(inputList);
+   // only a part of the events, e.g. ANALYSIS_SHARD=3/10 given by the batch job (the shard can be given as second argument)
+   if ( argc > 2 ) analysis.setShard(argv[2]);
+   else if ( const char * shard = std::getenv("ANALYSIS_SHARD") ) analysis.setShard(shard);
    
    // Physics Objects Collections
    analysis.addTree<Jet> ("Jets","MssmHbb/Events/slimmedJetsReapplyJEC");
    // GenParticles (when needed)
    analysis.addTree<GenParticle> ("GenParticles","MssmHbb/Events/prunedGenParticles");
 
-   // Use external btagging efficiencies
-   analysis.addBtagEfficiencies("/afs/desy.de/user/w/walsh/cms/analysis/cmssw/dev/CMSSW_7_6_5/src/Analysis/Objects/bin/BtagEfficiencies_btag_csvivf_0.935.root");
+   // Use external btagging efficiencies (the file can be given as argument)
+   std::string btagEffFile = "/afs/desy.de/user/w/walsh/cms/analysis/cmssw/dev/CMSSW_7_6_5/src/Analysis/Objects/bin/BtagEfficiencies_btag_csvivf_0.935.root";
+   if ( argc > 1 ) btagEffFile = argv[1];
+   analysis.addBtagEfficiencies(btagEffFile);
    analysis.btagEfficienciesAlgo("btag_csvivf");  // only needed above a certain commit where this information should be available in the title of the root file above
    analysis.btagEfficienciesFlavour("Extended");  // only needed above a certain commit where this information should be available in the title of the root file above
    
@@ -24,7 +24,7 @@ int main(int argc, char * argv[])
    Analysis analysis(inputList);
    
    // Physics Objects Collections
-   analysis.addTree<GenParticle> ("GenParticles","MssmHbb/Events/prunedGenParticles");
+   auto genParticlesHandle = analysis.addTree<GenParticle> ("GenParticles","MssmHbb/Events/prunedGenParticles");
    analysis.addTree<GenJet> ("GenJets","MssmHbb/Events/slimmedGenJets");
    analysis.addTree<Jet> ("Jets","MssmHbb/Events/slimmedJetsReapplyJEC");
 
@@ -48,26 +48,24 @@ int main(int argc, char * argv[])
       // until status=71, i.e. before hadronisation, which would be the best to use.
       // Thereofre, one can then try to follow the cascade down to the last b quarks
       // using delta_R matching. Maybe maybe some delta_pt/pt... but that's not done here.
-      auto genParticles = analysis.collection<GenParticle>("GenParticles");
+      // The index gives the particles of a pdgId and status without scanning the collection
+      const GenParticleIndex & genParticles = analysis.genParticleIndex(genParticlesHandle);
       GenParticle bquark;
       GenParticle bbarquark;
-      for ( int j = 0 ; j < genParticles->size() ; ++j )
+      for ( auto & gp : genParticles.withPdg(36).status(61) )
       {
-         GenParticle gp = genParticles->at(j);
-         if ( gp.pdgId() == 36 && gp.status() > 60 )
-         {
-            std::cout << "I am the higgs! "           << " : ";
-            std::cout << "pT  = "     << gp.pt()      << ", ";
-            std::cout << "eta = "     << gp.eta()     << ", ";
-            std::cout << "phi = "     << gp.phi()     << ", ";
-            std::cout << "pdgId = "   << gp.pdgId()   << ", ";
-            std::cout << "status = "  << gp.status()  << std::endl;
-         }
-         if ( fabs(gp.pdgId()) == 5 && gp.higgsDaughter() ) 
-         {
-            if ( gp.pdgId() > 0 )  bquark = gp;
-            if ( gp.pdgId() < 0 )  bbarquark = gp;
-         }
+         if ( gp.pdgId() != 36 ) continue;
+         std::cout << "I am the higgs! "           << " : ";
+         std::cout << "pT  = "     << gp.pt()      << ", ";
+         std::cout << "eta = "     << gp.eta()     << ", ";
+         std::cout << "phi = "     << gp.phi()     << ", ";
+         std::cout << "pdgId = "   << gp.pdgId()   << ", ";
+         std::cout << "status = "  << gp.status()  << std::endl;
+      }
+      for ( auto & gp : genParticles.higgsDaughters() )
+      {
+         if ( gp->pdgId() ==  5 )  bquark = *gp;
+         if ( gp->pdgId() == -5 )  bbarquark = *gp;
       }
 
       std::cout << "   I am a higgs b quark daughter! " << " : ";
@@ -86,78 +84,45 @@ int main(int argc, char * argv[])
       
 // ====================================================================      
       
-      // Generated jets
-      // Let's match with the Higgs daughters
+      // Truth chain: Higgs daughters -> generated jets -> reconstructed jets,
+      // unique matching within delta R < 0.3, the closest pairs first
       auto genJets = analysis.collection<GenJet>("GenJets");
-      GenJet bgenjet;
-      GenJet bbargenjet;
-      int nb = 0;
-      int nbbar = 0;
-      for ( int j = 0 ; j < genJets->size() ; ++j )
+      auto jets = analysis.collection<Jet>("Jets");
+      std::vector<const GenParticle *> quarks = { &bquark, &bbarquark };
+      TruthMatcher truth;
+      truth.add(quarks);
+      truth.add(genJets->candidates(), 0.3);
+      truth.add(jets->candidates(), 0.3);
+      truth.match();
+      
+      const std::string names[] = { "b", "bbar" };
+      for ( size_t q = 0 ; q < truth.size() ; ++q )
       {
-         GenJet gjet = genJets->at(j);
-         if ( gjet.deltaR(bquark) < 0.3 && nb == 0)
+         const Candidate * genjet = truth.object(q,1);
+         const Candidate * jet    = truth.object(q,2);
+         std::cout << "       I am a gen jet matched to a higgs daughter " << names[q] << " quark! " << " : ";
+         if ( genjet )
          {
-            bgenjet = gjet ;
-            ++nb;
+            std::cout << "pT  = "     << genjet->pt()      << ", ";
+            std::cout << "eta = "     << genjet->eta()     << ", ";
+            std::cout << "phi = "     << genjet->phi()     << ", " << std::endl;
          }
-         if ( gjet.deltaR(bbarquark) < 0.3 && nbbar == 0 )
+         else
          {
-            bbargenjet = gjet ;
-            std::cout << "       I am a gen jet matched to a higgs daughter bbar! " << " : ";
-            std::cout << "pT  = "     << gjet.pt()      << ", ";
-            std::cout << "eta = "     << gjet.eta()     << ", ";
-            std::cout << "phi = "     << gjet.phi()     << ", " << std::endl;
-            ++nbbar;
+            std::cout << "none" << std::endl;
          }
-         if ( nb > 0 && nbbar > 0 ) break;
-      }
-      
-      std::cout << "       I am a gen jet matched to a higgs daughter b quark! " << " : ";
-      std::cout << "pT  = "     << bgenjet.pt()      << ", ";
-      std::cout << "eta = "     << bgenjet.eta()     << ", ";
-      std::cout << "phi = "     << bgenjet.phi()     << ", " << std::endl;
-      
-      std::cout << "       I am a gen jet matched to a higgs daughter bbar quark! " << " : ";
-      std::cout << "pT  = "     << bbargenjet.pt()      << ", ";
-      std::cout << "eta = "     << bbargenjet.eta()     << ", ";
-      std::cout << "phi = "     << bbargenjet.phi()     << ", " << std::endl;
-      
-// ====================================================================      
-      
-      
-      nb = 0;
-      nbbar = 0;
-      // reconstructed jets
-      // will now try to match the gen jets that are daughter of the higgs to the reconstructed jets
-      auto jets = analysis.collection<Jet>("Jets");
-      Jet bjet;
-      Jet bbarjet;
-      for ( int j = 0 ; j < jets->size() ; ++j )
-      {
-         Jet jet = jets->at(j);
-         if ( bgenjet.deltaR(jet) < 0.3 && nb == 0 )
+         std::cout << "            I am a reco jet matched to a higgs daughter " << names[q] << " quark! " << " : ";
+         if ( jet )
          {
-            bjet = jet ;
-            ++nb;
+            std::cout << "pT  = "     << jet->pt()      << ", ";
+            std::cout << "eta = "     << jet->eta()     << ", ";
+            std::cout << "phi = "     << jet->phi()     << ", " << std::endl;
          }
-         if ( bbargenjet.deltaR(jet) < 0.3 && nbbar == 0 )
+         else
          {
-            bbarjet = jet ;
-            ++nbbar;
+            std::cout << "none" << std::endl;
          }
-         if ( nb > 0 && nbbar > 0 ) break;
-         
       }
-      std::cout << "            I am a reco jet matched to a higgs daughter b quark! " << " : ";
-      std::cout << "pT  = "     << bjet.pt()      << ", ";
-      std::cout << "eta = "     << bjet.eta()     << ", ";
-      std::cout << "phi = "     << bjet.phi()     << ", " << std::endl;
-      
-      std::cout << "            I am a reco jet matched to a higgs daughter bbar quark! " << " : ";
-      std::cout << "pT  = "     << bbarjet.pt()      << ", ";
-      std::cout << "eta = "     << bbarjet.eta()     << ", ";
-      std::cout << "phi = "     << bbarjet.phi()     << ", " << std::endl;
    }
    
 //    
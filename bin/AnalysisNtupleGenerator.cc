@@ -0,0 +1,620 @@
+// Writes synthetic ntuples with the MssmHbb layout read by Analysis.
+//
+// The files contain the event info, trigger results with prescales, jet
+// trees with btag, id, flavour and JER branches, generator particles and
+// jets, trigger objects, muons, MET and vertices in MssmHbb/Events, and the
+// cross sections and filter counters in MssmHbb/Metadata. Multiplicities are
+// drawn from Poisson distributions with configurable means and the jet pT
+// from a falling spectrum, so that all binaries and benchmarks can run
+// without access to the production ntuples.
+//
+// The object trees are titled "Class | InputTag" as in the ntuples. The
+// Higgs (pdg 36) is written with status 22 and as its last copy with status
+// 62; its daughters, flagged higgs_dau, are the two status 23 b quarks.
+// MC files have run = 1, which is how Analysis tells MC from data.
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TH2F.h"
+#include "TRandom.h"
+#include "TRandom3.h"
+#include "TLorentzVector.h"
+
+const int MAXOBJECTS = 1000;    // PhysicsObjectTreeBase<Object>::max_
+const int MAXVERTICES = 400;    // PhysicsObjectTreeBase<Vertex>::max_
+
+const std::vector<std::string> BTAGALGOS = { "btag_csvivf", "btag_csv",
+		"btag_jetbprob", "btag_jetprob", "btag_tchp", "btag_tche", "btag_svhe",
+		"btag_svhp", "btag_csvv2", "btag_csvlep", "btag_csvmva", "btag_deepb",
+		"btag_deepbb" };
+
+// Creates (if needed) and returns the directory path, e.g. MssmHbb/Events
+TDirectory * directory(TFile * file, const std::string & path) {
+	TDirectory * dir = file;
+	std::string rest = path;
+	while (not rest.empty()) {
+		std::string sub = rest.substr(0, rest.find('/'));
+		rest = rest.find('/') == std::string::npos ? "" : rest.substr(rest.find('/') + 1);
+		TDirectory * next = dir->GetDirectory(sub.c_str());
+		dir = next ? next : dir->mkdir(sub.c_str());
+	}
+	return dir;
+}
+
+// Branches common to all candidate trees
+struct Candidates {
+	int n;
+	float pt[MAXOBJECTS], eta[MAXOBJECTS], phi[MAXOBJECTS], e[MAXOBJECTS];
+	float px[MAXOBJECTS], py[MAXOBJECTS], pz[MAXOBJECTS];
+	int q[MAXOBJECTS];
+	TTree * tree;
+
+	// the title is "Class | InputTag", as in the ntuples
+	void book(TDirectory * dir, const std::string & name,
+			const std::string & cls) {
+		dir->cd();
+		tree = new TTree(name.c_str(), (cls + " | " + name).c_str());
+		tree->Branch("n", &n, "n/I");
+		tree->Branch("pt", pt, "pt[n]/F");
+		tree->Branch("eta", eta, "eta[n]/F");
+		tree->Branch("phi", phi, "phi[n]/F");
+		tree->Branch("e", e, "e[n]/F");
+		tree->Branch("px", px, "px[n]/F");
+		tree->Branch("py", py, "py[n]/F");
+		tree->Branch("pz", pz, "pz[n]/F");
+		tree->Branch("q", q, "q[n]/I");
+	}
+	void set(const int & i, const TLorentzVector & p4, const int & charge = 0) {
+		pt[i] = p4.Pt();
+		eta[i] = p4.Eta();
+		phi[i] = p4.Phi();
+		e[i] = p4.E();
+		px[i] = p4.Px();
+		py[i] = p4.Py();
+		pz[i] = p4.Pz();
+		q[i] = charge;
+	}
+};
+
+struct Jets: public Candidates {
+	float btag[13][MAXOBJECTS];
+	int flavour[MAXOBJECTS], hadronFlavour[MAXOBJECTS];
+	int partonFlavour[MAXOBJECTS], physicsFlavour[MAXOBJECTS];
+	float nHadFrac[MAXOBJECTS], nEmFrac[MAXOBJECTS], nMult[MAXOBJECTS];
+	float cHadFrac[MAXOBJECTS], cEmFrac[MAXOBJECTS], cMult[MAXOBJECTS];
+	float muonFrac[MAXOBJECTS];
+	float jecUncert[MAXOBJECTS];
+	float jerSF[MAXOBJECTS], jerSFUp[MAXOBJECTS], jerSFDown[MAXOBJECTS];
+	float jerResolution[MAXOBJECTS];
+
+	void book(TDirectory * dir, const std::string & name) {
+		Candidates::book(dir, name, "pat::Jet");
+		for (size_t a = 0; a < BTAGALGOS.size(); ++a)
+			tree->Branch(BTAGALGOS[a].c_str(), btag[a],
+					(BTAGALGOS[a] + "[n]/F").c_str());
+		tree->Branch("flavour", flavour, "flavour[n]/I");
+		tree->Branch("hadronFlavour", hadronFlavour, "hadronFlavour[n]/I");
+		tree->Branch("partonFlavour", partonFlavour, "partonFlavour[n]/I");
+		tree->Branch("physicsFlavour", physicsFlavour, "physicsFlavour[n]/I");
+		tree->Branch("id_nHadFrac", nHadFrac, "id_nHadFrac[n]/F");
+		tree->Branch("id_nEmFrac", nEmFrac, "id_nEmFrac[n]/F");
+		tree->Branch("id_nMult", nMult, "id_nMult[n]/F");
+		tree->Branch("id_cHadFrac", cHadFrac, "id_cHadFrac[n]/F");
+		tree->Branch("id_cEmFrac", cEmFrac, "id_cEmFrac[n]/F");
+		tree->Branch("id_cMult", cMult, "id_cMult[n]/F");
+		tree->Branch("id_muonFrac", muonFrac, "id_muonFrac[n]/F");
+		tree->Branch("jecUncert", jecUncert, "jecUncert[n]/F");
+		tree->Branch("jerSF", jerSF, "jerSF[n]/F");
+		tree->Branch("jerSFUp", jerSFUp, "jerSFUp[n]/F");
+		tree->Branch("jerSFDown", jerSFDown, "jerSFDown[n]/F");
+		tree->Branch("jerResolution", jerResolution, "jerResolution[n]/F");
+	}
+};
+
+struct GenParticles: public Candidates {
+	int pdg[MAXOBJECTS], status[MAXOBJECTS];
+	bool higgs_dau[MAXOBJECTS];
+
+	void book(TDirectory * dir, const std::string & name) {
+		Candidates::book(dir, name, "reco::GenParticle");
+		tree->Branch("pdg", pdg, "pdg[n]/I");
+		tree->Branch("status", status, "status[n]/I");
+		tree->Branch("higgs_dau", higgs_dau, "higgs_dau[n]/O");
+	}
+};
+
+struct METs: public Candidates {
+	float sigxx[MAXOBJECTS], sigxy[MAXOBJECTS], sigyx[MAXOBJECTS], sigyy[MAXOBJECTS];
+	float gen_px[MAXOBJECTS], gen_py[MAXOBJECTS], gen_pz[MAXOBJECTS];
+
+	void book(TDirectory * dir, const std::string & name, const bool & mc) {
+		Candidates::book(dir, name, "pat::MET");
+		tree->Branch("sigxx", sigxx, "sigxx[n]/F");
+		tree->Branch("sigxy", sigxy, "sigxy[n]/F");
+		tree->Branch("sigyx", sigyx, "sigyx[n]/F");
+		tree->Branch("sigyy", sigyy, "sigyy[n]/F");
+		if (not mc)
+			return;
+		tree->Branch("gen_px", gen_px, "gen_px[n]/F");
+		tree->Branch("gen_py", gen_py, "gen_py[n]/F");
+		tree->Branch("gen_pz", gen_pz, "gen_pz[n]/F");
+	}
+};
+
+struct Vertices {
+	int n;
+	float x[MAXVERTICES], y[MAXVERTICES], z[MAXVERTICES];
+	float xe[MAXVERTICES], ye[MAXVERTICES], ze[MAXVERTICES];
+	bool fake[MAXVERTICES];
+	float chi2[MAXVERTICES], ndof[MAXVERTICES], rho[MAXVERTICES];
+	TTree * tree;
+
+	void book(TDirectory * dir, const std::string & name) {
+		dir->cd();
+		tree = new TTree(name.c_str(), ("reco::Vertex | " + name).c_str());
+		tree->Branch("n", &n, "n/I");
+		tree->Branch("x", x, "x[n]/F");
+		tree->Branch("y", y, "y[n]/F");
+		tree->Branch("z", z, "z[n]/F");
+		tree->Branch("xe", xe, "xe[n]/F");
+		tree->Branch("ye", ye, "ye[n]/F");
+		tree->Branch("ze", ze, "ze[n]/F");
+		tree->Branch("fake", fake, "fake[n]/O");
+		tree->Branch("chi2", chi2, "chi2[n]/F");
+		tree->Branch("ndof", ndof, "ndof[n]/F");
+		tree->Branch("rho", rho, "rho[n]/F");
+	}
+};
+
+struct EventInfo {
+	int event, run, lumisection;
+	int nPileup;
+	float nTruePileup, lumiPileup, instantLumi;
+	double genWeight, genScale;
+	int pdfid1, pdfid2;
+	double pdfx1, pdfx2;
+	TTree * tree;
+
+	void book(TDirectory * dir, const bool & mc) {
+		dir->cd();
+		tree = new TTree("EventInfo", "edm::EventAuxiliary | EventInfo");
+		tree->Branch("event", &event, "event/I");
+		tree->Branch("run", &run, "run/I");
+		tree->Branch("lumisection", &lumisection, "lumisection/I");
+		if (mc) {
+			tree->Branch("nPileup", &nPileup, "nPileup/I");
+			tree->Branch("nTruePileup", &nTruePileup, "nTruePileup/F");
+			tree->Branch("genWeight", &genWeight, "genWeight/D");
+			tree->Branch("genScale", &genScale, "genScale/D");
+			tree->Branch("pdfid1", &pdfid1, "pdfid1/I");
+			tree->Branch("pdfid2", &pdfid2, "pdfid2/I");
+			tree->Branch("pdfx1", &pdfx1, "pdfx1/D");
+			tree->Branch("pdfx2", &pdfx2, "pdfx2/D");
+		} else {
+			tree->Branch("lumiPileup", &lumiPileup, "lumiPileup/F");
+			tree->Branch("instantLumi", &instantLumi, "instantLumi/F");
+		}
+	}
+};
+
+struct TriggerResults {
+	std::vector<std::string> paths;
+	bool accept[100];
+	int psl1[100], pshlt[100];
+	TTree * tree;
+
+	void book(TDirectory * dir, const std::vector<std::string> & triggers) {
+		dir->cd();
+		paths = triggers;
+		if (paths.size() > 100)
+			paths.resize(100);
+		tree = new TTree("TriggerResults", "edm::TriggerResults | TriggerResults");
+		for (size_t t = 0; t < paths.size(); ++t) {
+			tree->Branch(paths[t].c_str(), &accept[t], (paths[t] + "/O").c_str());
+			tree->Branch(("psl1_" + paths[t]).c_str(), &psl1[t],
+					("psl1_" + paths[t] + "/I").c_str());
+			tree->Branch(("pshlt_" + paths[t]).c_str(), &pshlt[t],
+					("pshlt_" + paths[t] + "/I").c_str());
+		}
+	}
+};
+
+// Poisson multiplicity with a minimum, limited to the size of the tree arrays
+int multiplicity(TRandom & rnd, const double & mean, const int & min,
+		const int & max) {
+	int n = rnd.Poisson(mean);
+	return std::min(std::max(n, min), max);
+}
+
+// Four-momentum with a falling pT spectrum starting at ptmin
+TLorentzVector momentum(TRandom & rnd, const double & ptmin,
+		const double & slope, const double & etamax, const double & mass) {
+	TLorentzVector p4;
+	p4.SetPtEtaPhiM(ptmin + rnd.Exp(slope), rnd.Uniform(-etamax, etamax),
+			rnd.Uniform(-M_PI, M_PI), mass);
+	return p4;
+}
+
+// Discriminator peaking at 1 for b jets, at 0 for light jets, in between for c jets
+float discriminator(TRandom & rnd, const int & flavour) {
+	double u = rnd.Rndm();
+	if (flavour == 5)
+		return 1. - 0.5 * std::pow(u, 3);
+	if (flavour == 4)
+		return std::pow(u, 0.7);
+	return std::pow(u, 4);
+}
+
+int main(int argc, char * argv[]) {
+	std::string output, fileList, metadata, events, btagEff;
+	std::vector<std::string> jetTrees, triggers, trgobjs;
+	int nfiles, nevents, seed;
+	double meanJets, meanGenParticles, meanMuons, meanVertices, meanTrgObjs;
+	double trigEff, xsection, autoflush;
+	bool data;
+
+	try {
+		po::options_description desc("Allowed options");
+		desc.add_options()("help,h", "Produce help message.")("output,o",
+				po::value < std::string > (&output)->default_value("synthetic"),
+				"Prefix of the output files, written as <prefix>_<n>.root.")(
+				"list", po::value < std::string > (&fileList)->default_value(
+						"syntheticFileList.txt"),
+				"File list of the output files, to be used as input list.")(
+				"files", po::value<int>(&nfiles)->default_value(1),
+				"Number of files.")("events",
+				po::value<int>(&nevents)->default_value(10000),
+				"Number of events per file.")("seed",
+				po::value<int>(&seed)->default_value(4357),
+				"Seed of the random numbers.")("data",
+				po::bool_switch(&data)->default_value(false),
+				"Write data-like files (no generator information).")(
+				"events-path", po::value < std::string > (&events)->default_value(
+						"MssmHbb/Events"), "Directory of the event trees.")(
+				"metadata-path", po::value < std::string
+						> (&metadata)->default_value("MssmHbb/Metadata"),
+				"Directory of the metadata trees.")("jettree",
+				po::value < std::vector<std::string>
+						> (&jetTrees)->composing(),
+				"Name of a jet tree (repeatable), default selectedUpdatedPatJetsPuppi, "
+						"slimmedJetsPuppi, slimmedJetsReapplyJEC.")("trigger",
+				po::value < std::vector<std::string>
+						> (&triggers)->composing(),
+				"Trigger path in TriggerResults (repeatable).")("trigobj",
+				po::value < std::vector<std::string>
+						> (&trgobjs)->composing(),
+				"Trigger object label in selectedPatTrigger (repeatable).")(
+				"jets", po::value<double>(&meanJets)->default_value(6.),
+				"Mean number of jets.")("genparticles",
+				po::value<double>(&meanGenParticles)->default_value(60.),
+				"Mean number of generator particles.")("muons",
+				po::value<double>(&meanMuons)->default_value(0.5),
+				"Mean number of muons.")("vertices",
+				po::value<double>(&meanVertices)->default_value(20.),
+				"Mean number of primary vertices.")("trigobjs",
+				po::value<double>(&meanTrgObjs)->default_value(3.),
+				"Mean number of trigger objects per label.")("trigeff",
+				po::value<double>(&trigEff)->default_value(0.3),
+				"Probability of a trigger to fire.")("xsection",
+				po::value<double>(&xsection)->default_value(1.),
+				"Cross section in pb.")("autoflush",
+				po::value<double>(&autoflush)->default_value(-30000000),
+				"Tree auto flush (< 0 in bytes, > 0 in entries), sets the cluster size.")(
+				"btageff", po::value < std::string > (&btagEff),
+				"Also write a file of btag efficiencies (extended flavours, btag_csvivf).");
+
+		po::variables_map vm;
+		po::store(po::parse_command_line(argc, argv, desc), vm);
+		if (vm.count("help")) {
+			std::cout << desc << std::endl;
+			return 0;
+		}
+		po::notify(vm);
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	if (jetTrees.empty())
+		jetTrees = { "selectedUpdatedPatJetsPuppi", "slimmedJetsPuppi",
+				"slimmedJetsReapplyJEC" };
+	if (triggers.empty())
+		triggers = {
+				"HLT_DoubleJetsC100_DoubleBTagCSV_p014_DoublePFJetsC100MaxDeta1p6_v",
+				"HLT_DoubleJetsC100_DoubleBTagCSV_p026_DoublePFJetsC160_v",
+				"HLT_DoubleJetsC112_DoubleBTagCSV_p014_DoublePFJetsC112MaxDeta1p6_v",
+				"HLT_DoubleJetsC112_DoubleBTagCSV_p026_DoublePFJetsC172_v" };
+	if (trgobjs.empty())
+		trgobjs = { "hltL1sDoubleJetC100", "hltDoubleJetsC100",
+				"hltBTagCaloCSVp014DoubleWithMatching", "hltDoublePFJetsC100",
+				"hltDoublePFJetsC100MaxDeta1p6" };
+	bool mc = not data;
+	TRandom3 rnd(seed);
+
+	std::ofstream list(fileList.c_str());
+	int eventNumber = 0;
+	for (int f = 0; f < nfiles; ++f) {
+		std::string fileName = output + "_" + std::to_string(f) + ".root";
+		TFile * file = new TFile(fileName.c_str(), "RECREATE");
+		TDirectory * dir = directory(file, events);
+		TDirectory * trgdir = directory(file, events + "/selectedPatTrigger");
+
+		EventInfo eventInfo;
+		eventInfo.book(dir, mc);
+		TriggerResults triggerResults;
+		triggerResults.book(dir, triggers);
+		std::vector<Jets*> jets;
+		for (auto & name : jetTrees) {
+			jets.push_back(new Jets);
+			jets.back()->book(dir, name);
+		}
+		GenParticles genParticles;
+		Candidates genJets;
+		if (mc) {
+			genParticles.book(dir, "prunedGenParticles");
+			genJets.book(dir, "slimmedGenJets", "reco::GenJet");
+		}
+		Candidates muons;
+		muons.book(dir, "slimmedMuons", "pat::Muon");
+		METs met;
+		met.book(dir, "slimmedMETs", mc);
+		Vertices vertices;
+		vertices.book(dir, "offlineSlimmedPrimaryVertices");
+		std::vector<Candidates*> trgObjects;
+		for (auto & label : trgobjs) {
+			trgObjects.push_back(new Candidates);
+			trgObjects.back()->book(trgdir, label,
+					"pat::TriggerObjectStandAlone");
+		}
+		std::vector<TTree*> trees = { eventInfo.tree, triggerResults.tree,
+				muons.tree, met.tree, vertices.tree };
+		for (auto & j : jets)
+			trees.push_back(j->tree);
+		for (auto & t : trgObjects)
+			trees.push_back(t->tree);
+		if (mc) {
+			trees.push_back(genParticles.tree);
+			trees.push_back(genJets.tree);
+		}
+		for (auto & t : trees)
+			t->SetAutoFlush((Long64_t) autoflush);
+
+		for (int i = 0; i < nevents; ++i) {
+			++eventNumber;
+
+			// event info
+			eventInfo.event = eventNumber;
+			eventInfo.run = mc ? 1 : 273158 + eventNumber / 1000000;
+			eventInfo.lumisection = 1 + (eventNumber % 1000000) / 1000;
+			eventInfo.nTruePileup = rnd.Uniform(5., 40.);
+			eventInfo.nPileup = rnd.Poisson(eventInfo.nTruePileup);
+			eventInfo.lumiPileup = rnd.Gaus(25., 5.);
+			eventInfo.instantLumi = rnd.Uniform(0.5, 1.5);
+			eventInfo.genWeight = rnd.Rndm() < 0.05 ? -1. : 1.;
+			eventInfo.genScale = rnd.Uniform(100., 500.);
+			eventInfo.pdfid1 = rnd.Rndm() < 0.5 ? 21 : 1 + rnd.Integer(5);
+			eventInfo.pdfid2 = rnd.Rndm() < 0.5 ? 21 : -1 - (int)rnd.Integer(5);
+			eventInfo.pdfx1 = std::pow(rnd.Rndm(), 3);
+			eventInfo.pdfx2 = std::pow(rnd.Rndm(), 3);
+
+			// trigger results
+			for (size_t t = 0; t < triggerResults.paths.size(); ++t) {
+				triggerResults.accept[t] = rnd.Rndm() < trigEff;
+				triggerResults.psl1[t] = 1;
+				triggerResults.pshlt[t] = 1;
+			}
+
+			// jets, pT ordered, the same physics objects in all jet trees; at most
+			// MAXOBJECTS-4, the generated particles are the Higgs, its last copy,
+			// its two daughters and one parton per jet
+			int nj = multiplicity(rnd, meanJets, 2, MAXOBJECTS - 4);
+			std::vector<TLorentzVector> p4s;
+			for (int j = 0; j < nj; ++j)
+				p4s.push_back(momentum(rnd, 20., 60., 4.7, rnd.Uniform(5., 20.)));
+			std::sort(p4s.begin(), p4s.end(),
+					[](const TLorentzVector & a, const TLorentzVector & b) {return a.Pt() > b.Pt();});
+			std::vector<int> flavours;
+			for (int j = 0; j < nj; ++j) {
+				double u = rnd.Rndm();
+				flavours.push_back(u < (j < 2 ? 0.6 : 0.15) ? 5 : (u < 0.75 ? 4 : 0));
+			}
+			for (auto & jet : jets) {
+				jet->n = nj;
+				for (int j = 0; j < nj; ++j) {
+					jet->set(j, p4s[j]);
+					int flav = flavours[j];
+					for (size_t a = 0; a < BTAGALGOS.size(); ++a)
+						jet->btag[a][j] = discriminator(rnd, flav);
+					jet->hadronFlavour[j] = flav;
+					jet->partonFlavour[j] = flav == 0 ? (rnd.Rndm() < 0.5 ? 21 : 1 + rnd.Integer(3)) : flav;
+					jet->flavour[j] = jet->partonFlavour[j];
+					jet->physicsFlavour[j] = jet->partonFlavour[j];
+					jet->nHadFrac[j] = rnd.Uniform(0., 0.3);
+					jet->nEmFrac[j] = rnd.Uniform(0., 0.3);
+					jet->nMult[j] = rnd.Poisson(5.);
+					jet->cHadFrac[j] = rnd.Uniform(0.3, 0.8);
+					jet->cEmFrac[j] = rnd.Uniform(0., 0.2);
+					jet->cMult[j] = 1 + rnd.Poisson(10.);
+					jet->muonFrac[j] = flav == 5 ? rnd.Uniform(0., 0.2) : rnd.Uniform(0., 0.02);
+					jet->jecUncert[j] = 0.01 + 0.5 / p4s[j].Pt();
+					jet->jerResolution[j] = 0.05 + 1. / std::sqrt(p4s[j].Pt());
+					jet->jerSF[j] = 1.1 + 0.1 * std::fabs(p4s[j].Eta()) / 4.7;
+					jet->jerSFUp[j] = jet->jerSF[j] + 0.05;
+					jet->jerSFDown[j] = jet->jerSF[j] - 0.05;
+				}
+			}
+
+			// generator information: genjets close to the jets, a Higgs
+			// decaying to the two leading b jets and the shower partons
+			if (mc) {
+				genJets.n = nj;
+				for (int j = 0; j < nj; ++j) {
+					TLorentzVector gen = p4s[j];
+					double res = 0.05 + 1. / std::sqrt(p4s[j].Pt());
+					gen.SetPtEtaPhiM(p4s[j].Pt() / std::max(0.5, 1. + rnd.Gaus(0., res)),
+							p4s[j].Eta() + rnd.Gaus(0., 0.02),
+							p4s[j].Phi() + rnd.Gaus(0., 0.02), p4s[j].M());
+					genJets.set(j, gen);
+				}
+				int np = std::max(multiplicity(rnd, meanGenParticles, 0, MAXOBJECTS), 2 * nj + 4);
+				np = std::min(np, MAXOBJECTS);
+				int p = 0;
+				// the hard process Higgs and its last copy, as in pythia8
+				TLorentzVector higgs = p4s[0] + p4s[1];
+				for (int status : { 22, 62 }) {
+					genParticles.set(p, higgs);
+					genParticles.pdg[p] = 36;
+					genParticles.status[p] = status;
+					genParticles.higgs_dau[p] = false;
+					++p;
+				}
+				// its daughters are the b quarks of the hard process
+				for (int b = 0; b < 2; ++b, ++p) {
+					genParticles.set(p, p4s[b], b == 0 ? -1 : 1);
+					genParticles.pdg[p] = b == 0 ? 5 : -5;
+					genParticles.status[p] = 23;
+					genParticles.higgs_dau[p] = true;
+				}
+				// partons before hadronisation, one per jet
+				for (int j = 0; j < nj; ++j, ++p) {
+					TLorentzVector parton;
+					parton.SetPtEtaPhiM(p4s[j].Pt() * rnd.Uniform(0.7, 1.1),
+							p4s[j].Eta() + rnd.Gaus(0., 0.05),
+							p4s[j].Phi() + rnd.Gaus(0., 0.05),
+							flavours[j] == 5 ? 4.8 : (flavours[j] == 4 ? 1.5 : 0.));
+					int pdg = flavours[j] == 0 ? (rnd.Rndm() < 0.5 ? 21 : 1 + rnd.Integer(3)) : flavours[j];
+					if (pdg != 21 && rnd.Rndm() < 0.5) pdg = -pdg;
+					genParticles.set(p, parton, pdg == 21 ? 0 : (pdg > 0 ? -1 : 1));
+					genParticles.pdg[p] = pdg;
+					genParticles.status[p] = 71;
+					genParticles.higgs_dau[p] = false;
+				}
+				// soft remnants
+				for (; p < np; ++p) {
+					genParticles.set(p, momentum(rnd, 0., 5., 5., 0.));
+					genParticles.pdg[p] = rnd.Rndm() < 0.5 ? 21 : 1 + rnd.Integer(3);
+					genParticles.status[p] = rnd.Rndm() < 0.5 ? 71 : 1;
+					genParticles.higgs_dau[p] = false;
+				}
+				genParticles.n = p;
+			}
+
+			// muons
+			muons.n = multiplicity(rnd, meanMuons, 0, MAXOBJECTS);
+			for (int m = 0; m < muons.n; ++m)
+				muons.set(m, momentum(rnd, 3., 15., 2.4, 0.106), rnd.Rndm() < 0.5 ? -1 : 1);
+
+			// missing energy balancing the jets
+			TLorentzVector sum;
+			for (auto & p4 : p4s)
+				sum += p4;
+			TLorentzVector miss;
+			miss.SetPxPyPzE(-sum.Px() * 0.1 + rnd.Gaus(0., 20.),
+					-sum.Py() * 0.1 + rnd.Gaus(0., 20.), 0., 0.);
+			miss.SetE(miss.Pt());
+			met.n = 1;
+			met.set(0, miss);
+			met.sigxx[0] = 400. + rnd.Exp(200.);
+			met.sigyy[0] = 400. + rnd.Exp(200.);
+			met.sigxy[0] = met.sigyx[0] = rnd.Gaus(0., 50.);
+			met.gen_px[0] = miss.Px() + rnd.Gaus(0., 10.);
+			met.gen_py[0] = miss.Py() + rnd.Gaus(0., 10.);
+			met.gen_pz[0] = 0.;
+
+			// vertices, the first one being the hard interaction
+			vertices.n = multiplicity(rnd, meanVertices, 1, MAXVERTICES);
+			for (int v = 0; v < vertices.n; ++v) {
+				vertices.x[v] = rnd.Gaus(0.1, 0.01);
+				vertices.y[v] = rnd.Gaus(0.1, 0.01);
+				vertices.z[v] = rnd.Gaus(0., 4.5);
+				vertices.xe[v] = vertices.ye[v] = 0.002;
+				vertices.ze[v] = 0.003;
+				vertices.fake[v] = rnd.Rndm() < 0.01;
+				vertices.ndof[v] = v == 0 ? 50. + rnd.Exp(50.) : rnd.Exp(20.);
+				vertices.chi2[v] = vertices.ndof[v] * rnd.Uniform(0.8, 1.2);
+				vertices.rho[v] = std::sqrt(vertices.x[v] * vertices.x[v] + vertices.y[v] * vertices.y[v]);
+			}
+
+			// trigger objects close to the leading jets
+			for (auto & obj : trgObjects) {
+				obj->n = std::min(multiplicity(rnd, meanTrgObjs, 0, MAXOBJECTS), nj);
+				for (int o = 0; o < obj->n; ++o) {
+					TLorentzVector p4;
+					p4.SetPtEtaPhiM(p4s[o].Pt() * rnd.Gaus(1., 0.1),
+							p4s[o].Eta() + rnd.Gaus(0., 0.05),
+							p4s[o].Phi() + rnd.Gaus(0., 0.05), 0.);
+					obj->set(o, p4);
+				}
+			}
+
+			for (auto & t : trees)
+				t->Fill();
+		}
+
+		// metadata: cross sections and filter counters
+		TDirectory * meta = directory(file, metadata);
+		meta->cd();
+		int run = mc ? 1 : 273158;
+		double crossSection = xsection;
+		double crossSectionError = 0.1 * xsection;
+		TTree * xsTree = new TTree("CrossSections", "CrossSections");
+		xsTree->Branch("run", &run, "run/I");
+		xsTree->Branch("crossSection", &crossSection, "crossSection/D");
+		xsTree->Branch("crossSectionError", &crossSectionError, "crossSectionError/D");
+		xsTree->Fill();
+		unsigned int total = nevents, filtered = nevents;
+		TTree * evtFilter = new TTree("EventFilter", "EventFilter");
+		evtFilter->Branch("nEventsTotal", &total, "nEventsTotal/i");
+		evtFilter->Branch("nEventsFiltered", &filtered, "nEventsFiltered/i");
+		evtFilter->Fill();
+		unsigned int gentotal = 2 * nevents;
+		TTree * genFilter = new TTree("GeneratorFilter", "GeneratorFilter");
+		genFilter->Branch("nEventsTotal", &gentotal, "nEventsTotal/i");
+		genFilter->Branch("nEventsFiltered", &filtered, "nEventsFiltered/i");
+		genFilter->Fill();
+
+		file->Write();
+		file->Close();
+		delete file;
+		for (auto & j : jets)
+			delete j;
+		for (auto & t : trgObjects)
+			delete t;
+
+		list << fileName << std::endl;
+		std::cout << "Written " << fileName << " with " << nevents << " events"
+				<< std::endl;
+	}
+	std::cout << "File list: " << fileList << std::endl;
+
+	// btag efficiencies as read by Analysis::addBtagEfficiencies
+	if (not btagEff.empty()) {
+		TFile * file = new TFile(btagEff.c_str(), "RECREATE", "Extended:btag_csvivf");
+		std::map<std::string, float> plateau = { { "b", 0.70 }, { "bb", 0.75 },
+				{ "c", 0.15 }, { "cc", 0.20 }, { "l", 0.01 } };
+		for (auto & f : plateau) {
+			std::string name = "h_" + f.first + "jet_eff_pt_eta";
+			TH2F * h = new TH2F(name.c_str(), "", 20, 0., 1000., 6, 0., 3.);
+			for (int x = 1; x <= 20; ++x)
+				for (int y = 1; y <= 6; ++y)
+					h->SetBinContent(x, y, f.second * (1. - 0.3 * std::exp(-x / 3.)) * (1. - 0.05 * y));
+		}
+		file->Write();
+		file->Close();
+		delete file;
+		std::cout << "btag efficiencies: " << btagEff << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,360 @@
+// Runs N shards of an analysis binary on the local machine and merges their outputs.
+//
+//    analysis-run -j N <binary> <cfg>
+//    analysis-run -j N [-o <merged output>] -- <binary> <arguments>
+//
+// In the first form each worker is started as "<binary> -c <cfg> --output <output>",
+// as AnalyseHBB expects. In the second form the arguments are given as they are,
+// with {output} replaced by the output file of the worker and {shard} by k/N.
+// Without {shard} the workers get ANALYSIS_SHARD=k/N in their environment, which
+// the binaries take as their shard. The outputs are written in a temporary directory
+// in $TMPDIR (or --tmpdir) and merged. The cut flows and the number of events are
+// taken from the merged file, where the workers wrote them as histograms with one
+// labelled bin per cut ("cutflow*") and as the parameter "events", and the aggregate
+// throughput is reported.
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TH1.h"
+#include "TParameter.h"
+#include "TFileMerger.h"
+
+//A cut flow table as written by the analysis binaries.
+struct CutFlowTable {
+	std::string title;
+	std::vector<std::string> descriptions;
+	std::vector<unsigned long> nsel;
+};
+
+//A worker process running one shard.
+struct Worker {
+	pid_t pid;
+	int fd;
+	std::string output;
+	std::string log;
+	int status;
+	double seconds;
+};
+
+std::ostream& operator<<(std::ostream& os, const CutFlowTable& obj) {
+	size_t sp[] = { 25, 12, 12, 12 };
+	sp[0] = std::max(sp[0], obj.title.size() + 3);
+	for (const auto& d : obj.descriptions)
+		sp[0] = std::max(sp[0], d.size() + 3);
+
+	os << std::setw(sp[0]) << std::left << obj.title << std::setw(sp[1])
+			<< std::right << "# events" << std::setw(sp[2]) << "absolute"
+			<< std::setw(sp[3]) << "relative";
+	for (unsigned int i = 0; i < obj.nsel.size(); ++i) {
+		float fracAbs = (float) obj.nsel[i] / obj.nsel[0];
+		float fracRel = 1.;
+		if (i > 0)
+			fracRel = (float) obj.nsel[i] / obj.nsel[i - 1];
+
+		os << std::endl;
+		os << std::setw(sp[0]) << std::left << obj.descriptions[i]
+				<< std::setw(sp[1]) << std::right << obj.nsel[i] << std::fixed
+				<< std::setw(sp[2]) << std::setprecision(6) << fracAbs
+				<< std::setw(sp[3]) << fracRel;
+	}
+	return os;
+}
+
+//The cut flows and the number of events of the merged output. The counters
+//were added up by the merger, as the histograms.
+void read_counters(const std::string& output_file,
+		std::vector<CutFlowTable>& tables, long& nevents) {
+	nevents = -1;
+	TFile* file = TFile::Open(output_file.c_str());
+	if (not file or file->IsZombie()) {
+		delete file;
+		return;
+	}
+	TList* keys = file->GetListOfKeys();
+	for (int i = 0; keys and i < keys->GetSize(); ++i) {
+		std::string name = keys->At(i)->GetName();
+		if (name.compare(0, 7, "cutflow") != 0)
+			continue;
+		TH1* h = dynamic_cast<TH1*>(file->Get(name.c_str()));
+		if (not h)
+			continue;
+		CutFlowTable table;
+		table.title = h->GetTitle();
+		for (int b = 1; b <= h->GetNbinsX(); ++b) {
+			table.descriptions.push_back(h->GetXaxis()->GetBinLabel(b));
+			table.nsel.push_back((unsigned long) (h->GetBinContent(b) + 0.5));
+		}
+		tables.push_back(table);
+	}
+	TParameter<Long64_t>* events = dynamic_cast<TParameter<Long64_t>*>(file->Get("events"));
+	if (events)
+		nevents = events->GetVal();
+	file->Close();
+	delete file;
+}
+
+//The output file given in the configuration file, if any.
+std::string config_output(const std::string& config_file) {
+	std::string output_file = "histograms.root";
+	po::options_description config;
+	config.add_options()("output",
+			po::value < std::string > (&output_file)->default_value(output_file));
+	std::ifstream ifs(config_file.c_str());
+	if (ifs) {
+		po::variables_map vm;
+		po::store(po::parse_config_file(ifs, config, true), vm);
+		po::notify(vm);
+	}
+	return output_file;
+}
+
+//Replaces all occurrences of a placeholder in an argument.
+std::string substitute(std::string arg, const std::string& placeholder,
+		const std::string& value) {
+	for (size_t p = arg.find(placeholder); p != std::string::npos;
+			p = arg.find(placeholder, p + value.size()))
+		arg.replace(p, placeholder.size(), value);
+	return arg;
+}
+
+Worker start_worker(const std::string& binary,
+		const std::vector<std::string>& arguments, const std::string& output,
+		int k, int njobs) {
+	Worker w;
+	w.output = output;
+	w.status = -1;
+	w.seconds = 0;
+	std::string shard = std::to_string(k) + "/" + std::to_string(njobs);
+	std::vector<std::string> args = { binary };
+	bool shardArgument = false;
+	for (const auto& arg : arguments) {
+		shardArgument = shardArgument or arg.find("{shard}") != std::string::npos;
+		args.push_back(substitute(substitute(arg, "{output}", output), "{shard}", shard));
+	}
+	int fds[2];
+	if (pipe(fds) != 0) {
+		w.pid = -1;
+		return w;
+	}
+	w.pid = fork();
+	if (w.pid == 0) {
+		// worker: stdout and stderr go to the parent
+		dup2(fds[1], STDOUT_FILENO);
+		dup2(fds[1], STDERR_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		if (not shardArgument)
+			setenv("ANALYSIS_SHARD", shard.c_str(), 1);
+		std::vector<char*> argv;
+		for (auto& arg : args)
+			argv.push_back(&arg[0]);
+		argv.push_back(nullptr);
+		execvp(binary.c_str(), argv.data());
+		std::cerr << "Can not execute " << binary << ": " << strerror(errno)
+				<< std::endl;
+		_exit(127);
+	}
+	close(fds[1]);
+	w.fd = fds[0];
+	return w;
+}
+
+int main(int argc, char* argv[]) {
+	int njobs;
+	std::string binary, output_file, tmp;
+	std::vector<std::string> arguments;
+
+	try {
+		po::options_description generic("Allowed options");
+		generic.add_options()("help,h", "Produce help message.")("jobs,j",
+				po::value<int>(&njobs)->default_value(1),
+				"Number of worker processes, each running one shard of the events.")(
+				"output,o", po::value < std::string > (&output_file),
+				"Name of the merged output root file (default: the output of the "
+						"configuration file, or histograms.root).")("tmpdir",
+				po::value < std::string > (&tmp)->default_value(
+						getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp"),
+				"Directory of the outputs of the workers until they are merged.");
+
+		po::options_description hidden("Hidden options");
+		hidden.add_options()("binary", po::value < std::string > (&binary),
+				"Analysis binary.")("arguments",
+				po::value < std::vector<std::string> > (&arguments),
+				"Configuration file, or the arguments of the analysis binary.");
+
+		po::options_description cmdline_options;
+		cmdline_options.add(generic).add(hidden);
+
+		po::positional_options_description p;
+		p.add("binary", 1);
+		p.add("arguments", -1);
+
+		po::variables_map vm;
+		po::store(
+				po::command_line_parser(argc, argv).options(cmdline_options).positional(
+						p).run(), vm);
+
+		if (vm.count("help") or not vm.count("binary")
+				or not vm.count("arguments")) {
+			std::cout << "Usage: analysis-run -j N <binary> <cfg>" << std::endl;
+			std::cout << "       analysis-run -j N [-o <output>] -- <binary> <arguments with {output} and {shard}>" << std::endl;
+			std::cout << generic << std::endl;
+			return vm.count("help") ? 0 : 1;
+		}
+		po::notify(vm);
+
+		if (njobs < 1) {
+			std::cerr << "Invalid number of jobs: Less than 1." << std::endl;
+			return 1;
+		}
+		bool outputArgument = std::any_of(arguments.begin(), arguments.end(),
+				[](const std::string& arg) {return arg.find("{output}") != std::string::npos;});
+		if (not outputArgument) {
+			if (arguments.size() != 1) {
+				std::cerr << "The arguments of " << binary
+						<< " must give the output of the workers as {output}."
+						<< std::endl;
+				return 1;
+			}
+			// the configuration file of AnalyseHBB
+			if (output_file.empty())
+				output_file = config_output(arguments[0]);
+			arguments = { "-c", arguments[0], "--output", "{output}" };
+		}
+		if (output_file.empty())
+			output_file = "histograms.root";
+	} catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	// The outputs of the workers are removed after merging.
+	std::string tmpdir_template = tmp + "/analysis-run.XXXXXX";
+	std::vector<char> tmpdir(tmpdir_template.begin(), tmpdir_template.end());
+	tmpdir.push_back('\0');
+	if (not mkdtemp(tmpdir.data())) {
+		std::cerr << "Can not create a directory in " << tmp << std::endl;
+		return 1;
+	}
+
+	auto start_time = std::chrono::steady_clock::now();
+
+	std::vector<Worker> workers;
+	for (int k = 0; k < njobs; ++k) {
+		std::string output = std::string(tmpdir.data()) + "/shard_"
+				+ std::to_string(k) + ".root";
+		workers.push_back(start_worker(binary, arguments, output, k, njobs));
+		if (workers.back().pid < 0) {
+			std::cerr << "Can not start worker " << k << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "Started " << njobs << " workers of " << binary << std::endl;
+
+	// Collect the outputs of the workers as they come, they are only printed
+	// if the worker fails
+	unsigned int nrunning = workers.size();
+	char buffer[4096];
+	while (nrunning > 0) {
+		std::vector<pollfd> fds;
+		std::vector<unsigned int> index;
+		for (unsigned int i = 0; i < workers.size(); ++i) {
+			if (workers[i].fd < 0)
+				continue;
+			fds.push_back( { workers[i].fd, POLLIN, 0 });
+			index.push_back(i);
+		}
+		if (poll(fds.data(), fds.size(), -1) < 0 and errno != EINTR)
+			break;
+		for (unsigned int i = 0; i < fds.size(); ++i) {
+			if (not (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+				continue;
+			Worker& w = workers[index[i]];
+			ssize_t n = read(w.fd, buffer, sizeof(buffer));
+			if (n > 0) {
+				w.log.append(buffer, n);
+				continue;
+			}
+			// the worker closed its output: it is finished
+			close(w.fd);
+			w.fd = -1;
+			waitpid(w.pid, &w.status, 0);
+			w.seconds = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start_time).count();
+			--nrunning;
+		}
+	}
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start_time).count();
+
+	// Merge
+	int nfailed = 0;
+	TFileMerger merger(false);
+	merger.OutputFile(output_file.c_str(), "RECREATE");
+	for (unsigned int k = 0; k < workers.size(); ++k) {
+		Worker& w = workers[k];
+		bool ok = WIFEXITED(w.status) and WEXITSTATUS(w.status) == 0;
+		if (not ok) {
+			++nfailed;
+			std::cerr << "Worker " << k << " failed. Its output was:" << std::endl;
+			std::cerr << w.log << std::endl;
+			continue;
+		}
+		if (access(w.output.c_str(), R_OK) == 0)
+			merger.AddFile(w.output.c_str(), false);
+		else {
+			++nfailed;
+			std::cerr << "Worker " << k << " wrote no output " << w.output << std::endl;
+		}
+	}
+	bool merged = merger.Merge();
+
+	for (const auto& w : workers)
+		unlink(w.output.c_str());
+	rmdir(tmpdir.data());
+
+	std::vector<CutFlowTable> cutflows;
+	long nevents = -1;
+	if (merged)
+		read_counters(output_file, cutflows, nevents);
+
+	//Print statistics
+	std::cout << std::endl;
+	for (const auto& cf : cutflows)
+		std::cout << cf << std::endl << std::endl;
+
+	for (unsigned int k = 0; k < workers.size(); ++k)
+		std::cout << "Worker " << k << " took " << std::fixed
+				<< std::setprecision(1) << workers[k].seconds << " s." << std::endl;
+	std::cout << "Analysis took " << std::fixed << std::setprecision(1)
+			<< seconds << " s with " << njobs << " workers";
+	if (nevents >= 0)
+		std::cout << " for " << nevents << " events: " << std::setprecision(0)
+				<< nevents / seconds << " events/s";
+	std::cout << "." << std::endl;
+	if (merged)
+		std::cout << "Histograms merged into " << output_file << std::endl;
+	else
+		std::cerr << "Merging of the histograms into " << output_file
+				<< " failed." << std::endl;
+
+	return (nfailed == 0 and merged) ? 0 : 1;
+}
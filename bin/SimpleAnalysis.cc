@@ -1,6 +1,7 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <cstdlib>
 
 #include "TFile.h" 
 #include "TFileCollection.h"
@@ -37,6 +38,9 @@ int main(int argc, char * argv[])
    
    // Input files list
    Analysis analysis(inputList);
+   // only a part of the events, e.g. ANALYSIS_SHARD=3/10 given by the batch job
+   if ( argc > 1 ) analysis.setShard(argv[1]);
+   else if ( const char * shard = std::getenv("ANALYSIS_SHARD") ) analysis.setShard(shard);
    
    analysis.addTree<Jet> ("Jets","MssmHbb/Events/slimmedJetsPuppiReapplyJEC");
    
@@ -118,13 +122,7 @@ int main(int argc, char * argv[])
       
       // Jets - std::shared_ptr< Collection<Jet> >
       auto slimmedJets = analysis.collection<Jet>("Jets");
-      std::vector<Jet *> selectedJets;
-      for ( int j = 0 ; j < slimmedJets->size() ; ++j )
-      {
-         Jet* jet = &slimmedJets->at(j);
-         if (jet->idLoose())
-            selectedJets.push_back(jet);
-      }
+      auto selectedJets = slimmedJets->view().filter([](const Jet & jet) { return jet.idLoose(); });
       if ( selectedJets.size() < 3 ) continue;
       
       ++nsel[1];
@@ -132,8 +130,8 @@ int main(int argc, char * argv[])
       // Kinematic selection - 2 leading jets
       for ( int j = 0; j < 2; ++j )
       {
-         Jet * jet = selectedJets[j];
-         if ( jet->pt() < ptmin[j] || fabs(jet->eta()) > etamax[j] )
+         const Jet & jet = selectedJets[j];
+         if ( jet.pt() < ptmin[j] || fabs(jet.eta()) > etamax[j] )
          {
             goodEvent = false;
             break;
@@ -144,44 +142,30 @@ int main(int argc, char * argv[])
       
       ++nsel[2];
       
-      // Delta R selection
-      for ( int j1 = 0; j1 < 3 - 1; ++j1 )
-      {
-         const Jet& jet1 = *selectedJets[j1];
-         for ( int j2 = j1 + 1; j2 < 3; ++j2 )
-         {
-            const Jet& jet2 = *selectedJets[j2];
-            if ( jet1.deltaR(jet2) < dRmin )
-            {
-               goodEvent = false;
-               break;
-            }
-         }
-      }
+      // Delta R selection - all pairs of the 3 leading jets
+      for ( int i = 0; i < 2 && goodEvent; ++i )
+         for ( int j = i+1; j < 3; ++j )
+            if ( deltaR2(selectedJets[i].eta(), selectedJets[i].phi(), selectedJets[j].eta(), selectedJets[j].phi()) < dRmin*dRmin ) goodEvent = false;
       
       if ( ! goodEvent ) continue;
       
       ++nsel[3];
       
       //Delta eta selection - two leading jets
-      if ( fabs(selectedJets[0]->eta() - selectedJets[1]->eta()) > detamax ) continue;
+      if ( fabs(selectedJets[0].eta() - selectedJets[1].eta()) > detamax ) continue;
       
       ++nsel[4];
       
       
       // Fill histograms of kinematic passed events
-      for ( int j = 0 ; j < (int)selectedJets.size() ; ++j )
-      {
-         if ( selectedJets[j]->pt() < 20. ) continue;
-         ++njets;
-      }
+      njets = selectedJets.countPtMin(20.);
       
       //fill histrograms and btag selection
       h1["n"] -> Fill(selectedJets.size());
       h1["n_ptmin20"] -> Fill(njets);
       for ( int j = 0; j < 3; ++j )
       {
-         Jet * jet = selectedJets[j];
+         const Jet * jet = &selectedJets[j];
          h1[Form("pt_%i",j)]   -> Fill(jet->pt());
          h1[Form("eta_%i",j)]  -> Fill(jet->eta());
          h1[Form("phi_%i",j)]  -> Fill(jet->phi());
@@ -199,7 +183,7 @@ int main(int argc, char * argv[])
          }
       }
       
-      h1["m12"] -> Fill((selectedJets[0]->p4() + selectedJets[1]->p4()).M());
+      h1["m12"] -> Fill((selectedJets[0].p4() + selectedJets[1].p4()).M());
       
       if ( ! goodEvent ) continue;
       
@@ -211,7 +195,7 @@ int main(int argc, char * argv[])
       bool matched[10] = {true,true,true,true,true,true,true,true,true,true};
       for ( int j = 0; j < 2; ++j )
       {
-         Jet* jet = selectedJets[j];
+         const Jet * jet = &selectedJets[j];
          for ( size_t io = 0; io < triggerObjects.size() ; ++io )
          {       
             if ( ! jet->matched(triggerObjects[io]) ) matched[io] = false;
@@ -231,24 +215,20 @@ int main(int argc, char * argv[])
       ++nsel[6];
       
       // Fill histograms of passed bbnb btagging selection
-      for ( int j = 0 ; j < (int)selectedJets.size() ; ++j )
-      {
-         if ( selectedJets[j]->pt() < 20. ) continue;
-         ++njets_csv;
-      }
+      njets_csv = njets;
       //std::cout << selectedJets.size() << std::endl;
       h1["n_csv"] -> Fill(selectedJets.size());
       h1["n_ptmin20_csv"] -> Fill(njets_csv);
       for ( int j = 0; j < 3; ++j )
       {
-         Jet* jet = selectedJets[j];
+         const Jet * jet = &selectedJets[j];
          h1[Form("pt_%i_csv",j)]   -> Fill(jet->pt());
          h1[Form("eta_%i_csv",j)]  -> Fill(jet->eta());
          h1[Form("phi_%i_csv",j)]  -> Fill(jet->phi());
          h1[Form("btag_%i_csv",j)] -> Fill(jet->btag());
       }
 
-      if ( !isbbb ) h1["m12_csv"] -> Fill((selectedJets[0]->p4() + selectedJets[1]->p4()).M());
+      if ( !isbbb ) h1["m12_csv"] -> Fill((selectedJets[0].p4() + selectedJets[1].p4()).M());
    }
    
    for (auto & ih1 : h1)
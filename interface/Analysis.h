@@ -24,9 +24,11 @@
 #include <vector>
 #include <string>
 #include <typeinfo>
-#include <boost/any.hpp>
-#include <boost/core/demangle.hpp>
-#include <boost/algorithm/string.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
 #include "stdlib.h"
 //
 // user include files
@@ -37,9 +39,15 @@
 #include "TH2.h"
 
 #include "Analysis/Core/interface/Utils.h"
+#include "Analysis/Core/interface/FileManager.h"
 
 #include "Analysis/Core/interface/PhysicsObjectTree.h"
 #include "Analysis/Core/interface/Collection.h"
+#include "Analysis/Core/interface/Combinatorics.h"
+#include "Analysis/Core/interface/CompositeCandidate.h"
+#include "Analysis/Core/interface/DeltaRMatrix.h"
+#include "Analysis/Core/interface/JetVariations.h"
+#include "Analysis/Core/interface/TruthMatcher.h"
 
 //
 // class declaration
@@ -58,9 +66,14 @@ namespace analysis {
             std::string tag();
 
             // Event
+            /// number of events of the whole input, also after setRange or setShard
             int  numberEvents();
+            /// number of events in the range, i.e. of the loop over event(i); after a resume from a checkpoint those left
             int  size();
-            void event(const int & event, const bool & addCollections = true);
+            /// number of events in the range as given by setRange or setShard, also after a resume from a checkpoint
+            int  rangeSize();
+            /// reads an event; returns false if it fails the preselections, its object trees are then not read
+            bool event(const int & event, const bool & addCollections = true);
             int  event();
             int  run();
             int  lumiSection();
@@ -68,6 +81,19 @@ namespace analysis {
             std::string fileName();
             std::string fileFullName();
             
+            // Event range
+            /// restricts the events to the global entries [first,last); size() and event(i) are then relative to first
+            void setRange(const int & first, const int & last);
+            /// restricts the events to the k-th of n shards (k = 0..n-1), aligned to the tree clusters
+            /// and balanced on the number of entries or on the size of the files
+            void setShard(const int & k, const int & n, const bool & byBytes = false);
+            /// as above with the shard given as "k/n"
+            void setShard(const std::string & shard, const bool & byBytes = false);
+            int  firstEvent();
+            int  lastEvent();
+            /// returns the manager of the input files
+            FileManager * fileManager();
+            
             // PileupInfo
             int   nPileup();
             float nTruePileup();
@@ -82,10 +108,70 @@ namespace analysis {
             
 
             // Trees
+            /// declares the tree of objects in path; the handle gives a typed, indexed access to the tree and its collection
             template<class Object>
-            std::shared_ptr< PhysicsObjectTree<Object> > addTree(const std::string & unique_name, const std::string & path );
+            CollectionHandle<Object> addTree(const std::string & unique_name, const std::string & path );
             template<class Object>
             std::shared_ptr< PhysicsObjectTree<Object> > tree(const std::string & unique_name);
+            template<class Object>
+            std::shared_ptr< PhysicsObjectTree<Object> > tree(const CollectionHandle<Object> & handle);
+            /// handle of a tree or collection given its name; invalid if there is none of this type
+            template<class Object>
+            CollectionHandle<Object> handle(const std::string & unique_name);
+            
+            // Generated particles
+            /// index of the generated particles of the current event by |pdgId| and status, built once per event
+            const GenParticleIndex & genParticleIndex(const CollectionHandle<GenParticle> & handle);
+            
+            // Vertices
+            /// declares the vertex tree in path for its per-event summary, no Collection<Vertex> is built for it;
+            /// if the tree is already declared by addTree<Vertex>, the summary is computed from that tree
+            SummaryHandle<VertexSummary> addVertexSummary(const std::string & unique_name, const std::string & path);
+            /// nGoodPV, PV z and densities of the current event
+            const VertexSummary & vertexSummary(const SummaryHandle<VertexSummary> & handle);
+            
+            // Read cache
+            /// enables the TTreeCache of all trees: size in bytes (<= 0 sizes each tree from the branches read),
+            /// number of entries to learn which branches are read (0 caches the branches declared) and asynchronous prefetching
+            void treeCache(const Long64_t & size = 0, const int & learnEntries = 0, const bool & prefetch = false);
+            /// prints the cache hit rate and the bytes read so far
+            void listTreeCache();
+            
+            // Monitoring
+            /// prints the progress every given number of seconds (0 = never)
+            void monitor(const int & seconds);
+            /// returns the counters of the event loop
+            MonitorInfo monitorInfo();
+            /// prints the counters of the event loop
+            void listMonitor();
+            
+            // Checkpoint
+            /// adds a histogram to the checkpoint
+            void checkpointHistogram(TH1 * histogram);
+            /// adds counters, e.g. of a cut flow, to the checkpoint
+            void checkpointCounters(const std::string & name, std::vector<unsigned int> & counters);
+            /// writes a checkpoint to a file every given number of events and/or seconds (0 = not used).
+            /// If the file has a checkpoint of the same input, range and config (any text describing the job),
+            /// the histograms and counters are restored and the events start after the checkpoint; returns whether it resumed.
+            bool checkpoint(const std::string & file, const int & events, const int & seconds = 0, const std::string & config = "");
+            /// seconds spent in the event loop before the resume from a checkpoint, 0 if it did not resume
+            double checkpointElapsed();
+            
+            // Pipelined reading
+            /// reads the next event and builds its collections in a background thread while the current one is analysed.
+            /// The raw tree buffers then hold the next event: tree() and addCollection(name) read the current event
+            /// again, which loses the read ahead of that event, so use the collections and the event information instead.
+            void pipeline(const bool & on);
+            bool pipeline();
+            
+            // Staged reading
+            /// event() reads only the event information and the trigger results; each object tree is read,
+            /// and its collection built, when it is first accessed in the event. Not used together with the pipeline.
+            void stagedReading(const bool & on);
+            bool stagedReading();
+            /// adds a selection on the event information and trigger results (e.g. json, trigger bits),
+            /// run before the object trees are read; event() returns false for the events failing it
+            void addPreselection(const std::function<bool(Analysis &)> & selection);
             
             // Collections
             template<class Object>
@@ -93,15 +179,26 @@ namespace analysis {
             template<class Object>
             std::shared_ptr< Collection<Object> > addCollection(const Collection<Object> & collection);
             template<class Object>
+            std::shared_ptr< Collection<Object> > addCollection(Collection<Object> && collection);
+            template<class Object>
             std::shared_ptr< Collection<Object> > addCollection(const std::vector<Object> & objects, const std::string & unique_name );
             template<class Object>
+            std::shared_ptr< Collection<Object> > addCollection(std::vector<Object> && objects, const std::string & unique_name );
+            template<class Object>
             std::shared_ptr< Collection<Object> > collection(const std::string & unique_name);
+            /// as above without the look up of the name
+            template<class Object>
+            std::shared_ptr< Collection<Object> > collection(const CollectionHandle<Object> & handle);
             
             template<class Object>
             void defaultCollection(const std::string & unique_name);
             template<class Object>
             std::string defaultCollection();
             
+            // Random numbers
+            /// reproducible random numbers of a collection in the current event, e.g. for smearTo
+            RandomStream randomStream(const std::string & collection, const int & variation = 0);
+            
             // Cross sections
             void   crossSections(const std::string & path);
             double crossSection();
@@ -109,8 +206,12 @@ namespace analysis {
             void   listCrossSections();
             
             // Luminosity
+            /// of the whole input, numberEvents()/crossSection(); scaleLuminosity uses it, so that the
+            /// histograms of the shards of a job, each scaled on its own, add up to the scaled whole input
             double luminosity();
             double luminosity(const std::string & title);
+            /// of the events in the range only, rangeSize()/crossSection(), e.g. for a range analysed on its own
+            double rangeLuminosity();
 
             // Trigger results
             void triggerResults(const std::string & path);
@@ -130,6 +231,8 @@ namespace analysis {
             void match(const std::string & collection, const std::string & match_collection, const float & deltaR = 0.5);
             template <class Object1, class Object2>
             void match(const std::string & collection, const std::vector<std::string> & match_collections, const float & deltaR = 0.5);
+            template <class Object1, class Object2>
+            void match(const CollectionHandle<Object1> & collection, const CollectionHandle<Object2> & match_collection, const float & deltaR = 0.5);
             
             // good Json files
             void processJsonFile(const std::string & fileName = "goodJson.txt");
@@ -152,6 +255,9 @@ namespace analysis {
             TCollection * fileList_;
             std::string inputFilelist_;
             
+            // single open file per input shared by all trees
+            FileManager * files_;
+            
             // Info
             std::string tag_;
             
@@ -188,29 +294,107 @@ namespace analysis {
             PDF    pdf_;
 
             int nevents_;
+            int first_;
+            int last_;
+            int rangeFirst_;   // first event of the range, first_ moves to the event a checkpoint resumes from
 
             // TREES
-            void treeInit_(const std::string & unique_name, const std::string & path);
-            TChain * t_xsection_;
-            TChain * t_genfilter_;
-            TChain * t_evtfilter_;
-            TChain * t_event_;
-            TChain * t_triggerResults_;
+            TTree * treeInit_(const std::string & unique_name, const std::string & path);
+            void treesReload_();
+            void treeCache_(TreeBase * tree);
+            std::string xsectionPath_;
+            std::string genfilterPath_;
+            std::string evtfilterPath_;
+            std::string eventInfoPath_;
+            std::string triggerResultsPath_;
+            TreeBase * t_event_;
+            TreeBase * t_triggerResults_;
 
          // Physics objects
-            // root trees
-            std::map<std::string, TChain*> tree_;
-
-            // Framework trees and types
-            std::map<std::string, boost::any  > t_any_;
-            std::map<std::string, std::string > t_type_;
-            
-            // Collections
-            std::map<std::string, boost::any > c_any_;
+            // registry of the trees and their collections, the handles are indices of the slots
+            struct Slot
+            {
+               std::string name;
+               std::string path;                   // in the files, empty for collections not read from a tree
+               const std::type_info * type;        // of the objects
+               std::shared_ptr<TreeBase> tree;     // a PhysicsObjectTree<Object>
+               std::shared_ptr<void> collection;   // a Collection<Object>
+               std::shared_ptr<void> next;         // collection of the next event, built by the reader thread
+               std::shared_ptr<void> (Analysis::*build)(Slot &);   // builds the collection from the tree
+               bool staged;                        // tree not read yet in the current event
+               bool stageCollection;               // and its collection to be built when it is read
+               std::shared_ptr<void> index;        // e.g. a GenParticleIndex of the collection
+               int indexEntry;                     // event of the index
+               const void * indexOf;               // and its collection, which may be rebuilt in the same event
+               bool summary;                       // the collection is a per-event summary of the tree, e.g. a VertexSummary
+               int source;                         // slot reading the tree, if it is that of another slot; -1 if its own
+            };
+            int  slot_(const std::string & unique_name);
+            int  addSlot_(const std::string & unique_name, const std::type_info & type);
+            void collections_(const bool & next);
+            template<class Object>
+            std::shared_ptr<void> treeCollection_(Slot & slot);
+            std::shared_ptr<void> vertexSummary_(Slot & slot);
+            std::vector<Slot> slots_;
+            std::map<std::string, int> slotIndex_;
             
             // Luminosity
             float mylumi_;
             
+            // Monitoring
+            void monitor_();
+            int    monitorSeconds_;
+            long   nread_;
+            double readSeconds_;
+            double collectionSeconds_;
+            double userSeconds_;
+            bool   monitorStarted_;
+            std::chrono::steady_clock::time_point monitorStart_;
+            std::chrono::steady_clock::time_point monitorReport_;
+            std::chrono::steady_clock::time_point eventEnd_;
+            
+            // Checkpoint
+            void checkpointWrite_(const int & next);
+            std::string checkpointFile_;
+            std::string checkpointHash_;
+            int checkpointEvents_;
+            int checkpointSeconds_;
+            int checkpointLast_;
+            int checkpointStride_;   // events between the looks at the clock
+            double checkpointElapsed_;
+            std::chrono::steady_clock::time_point checkpointTime_;
+            std::vector<TH1 *> checkpointHistograms_;
+            std::map<std::string, std::vector<unsigned int> * > checkpointCounters_;
+            
+            // Pipelined reading: the reader thread decodes the next event into the buffers
+            void decode_(const int & event, const bool & addCollections);
+            void eventBranches_(const bool & buffer);
+            void readerLoop_();
+            void readerRequest_(const int & event, const bool & addCollections);
+            void readerWait_();
+            void readerCurrent_();
+            bool pipeline_;
+            int  entry_;   // current event
+            EventData buffer_;
+            std::thread reader_;
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            int  requested_;
+            int  decoded_;
+            bool requestedCollections_;
+            bool decodedCollections_;
+            bool stop_;
+            bool rereadWarned_;
+            
+            // Staged reading: the object trees not read yet in the current event are flagged in their slots
+            void stage_(const int & index);
+            void unstage_();
+            bool preselect_();
+            bool stagedReading_;
+            Long64_t stagedEntry_;
+            std::vector< std::function<bool(Analysis &)> > preselections_;
+            long npreselected_;
+            
          private:
 
 
@@ -227,25 +411,56 @@ namespace analysis {
 // -------------------------------------------------------
       // TREES
       template <class Object>
-      std::shared_ptr< PhysicsObjectTree<Object> >  Analysis::addTree(const std::string & unique_name, const std::string & path)
+      CollectionHandle<Object>  Analysis::addTree(const std::string & unique_name, const std::string & path)
       {
-         this->treeInit_(unique_name,path);
-         t_any_[unique_name] = std::shared_ptr< PhysicsObjectTree<Object> > ( new PhysicsObjectTree<Object>(tree_[unique_name], unique_name) );
-         std::string type = boost::core::demangle(typeid(Object).name());
-         std::vector<std::string> tmp;
-         boost::split( tmp, type, boost::is_any_of("::"));
-         t_type_[unique_name] = tmp.back();
-         return boost::any_cast< std::shared_ptr< PhysicsObjectTree<Object> > > (t_any_[unique_name]);
+         // the reader thread must not be using the trees
+         this->readerWait_();
+         decoded_ = -1;
+         TTree * t = this->treeInit_(unique_name,path);
+         if ( ! t ) return CollectionHandle<Object>();
+         int index = this->addSlot_(unique_name, typeid(Object));
+         if ( index < 0 ) return CollectionHandle<Object>();
+         Slot & slot = slots_[index];
+         slot.path  = path;
+         slot.tree  = std::make_shared< PhysicsObjectTree<Object> >(t, unique_name);
+         slot.build = &Analysis::treeCollection_<Object>;
+         this->treeCache_(slot.tree.get());
+         return CollectionHandle<Object>(index, unique_name);
       }
       // --
       template <class Object>
       std::shared_ptr< PhysicsObjectTree<Object> >  Analysis::tree(const std::string & unique_name)
       {
          // If tree does not exist, return NULL
-         std::map<std::string, boost::any >::iterator it = t_any_.find(unique_name);
-         if ( it == t_any_.end() )
-            return nullptr;
-         return boost::any_cast< std::shared_ptr< PhysicsObjectTree<Object> > > (t_any_[unique_name]);
+         return this->tree(this->handle<Object>(unique_name));
+      }
+      // --
+      template <class Object>
+      std::shared_ptr< PhysicsObjectTree<Object> >  Analysis::tree(const CollectionHandle<Object> & handle)
+      {
+         if ( ! handle.valid() ) return nullptr;
+         // the raw buffers must hold the current event
+         this->readerCurrent_();
+         this->stage_(handle.index);
+         return std::static_pointer_cast< PhysicsObjectTree<Object> > (slots_[handle.index].tree);
+      }
+      // --
+      template <class Object>
+      CollectionHandle<Object>  Analysis::handle(const std::string & unique_name)
+      {
+         int index = this->slot_(unique_name);
+         if ( index < 0 ) return CollectionHandle<Object>();
+         if ( *slots_[index].type != typeid(Object) )
+         {
+            std::cout << "Collection " << unique_name << " is not of type " << typeid(Object).name() << std::endl;
+            return CollectionHandle<Object>();
+         }
+         if ( slots_[index].summary )
+         {
+            std::cout << unique_name << " is a summary, not a collection" << std::endl;
+            return CollectionHandle<Object>();
+         }
+         return CollectionHandle<Object>(index, unique_name);
       }
 // -------------------------------------------------------
       // COLLECTIONS
@@ -256,51 +471,78 @@ namespace analysis {
          // e.g. a selected jets collection from the ntuple jets collection.
          
          // If tree does not exist, return NULL
-         std::map<std::string, boost::any >::iterator it = t_any_.find(unique_name);
-         if ( it == t_any_.end() )
+         CollectionHandle<Object> h = this->handle<Object>(unique_name);
+         if ( ! h.valid() || ! slots_[h.index].tree )
             return nullptr;
          
-         auto tree = boost::any_cast< std::shared_ptr< PhysicsObjectTree<Object> > > (t_any_[unique_name]);
-         c_any_[unique_name] = std::shared_ptr< Collection<Object> > ( new Collection<Object>(tree -> collection()));
-         std::shared_ptr< Collection<Object> > ret = boost::any_cast< std::shared_ptr< Collection<Object> > > (c_any_[unique_name]);
-         
-         return ret;
+         this->readerCurrent_();
+         this->stage_(h.index);
+         slots_[h.index].collection = this->treeCollection_<Object>(slots_[h.index]);
+         return this->collection(h);
       }
       
       template <class Object>
       std::shared_ptr< Collection<Object> >  Analysis::addCollection(const Collection<Object> & collection)
       {
-         std::string unique_name = collection.name();
-         t_any_[unique_name] = nullptr;
-         c_any_[unique_name] = std::shared_ptr< Collection<Object> > ( new Collection<Object>(collection) );
-         std::shared_ptr< Collection<Object> > ret = boost::any_cast< std::shared_ptr< Collection<Object> > > (c_any_[unique_name]);
-         
+         return this->addCollection(Collection<Object>(collection));
+      }
+      
+      template <class Object>
+      std::shared_ptr< Collection<Object> >  Analysis::addCollection(Collection<Object> && collection)
+      {
+         // a new slot grows the slots the reader thread loops over, so it must be idle;
+         // the collection of an existing slot is that of the current event, the reader only sets next
+         if ( this->slot_(collection.name()) < 0 )
+            this->readerWait_();
+         int index = this->addSlot_(collection.name(), typeid(Object));
+         if ( index < 0 ) return nullptr;
+         std::shared_ptr< Collection<Object> > ret = std::make_shared< Collection<Object> >(std::move(collection));
+         slots_[index].collection = ret;
          return ret;
       }
       
       template <class Object>
       std::shared_ptr< Collection<Object> >  Analysis::addCollection(const std::vector<Object> & objects , const std::string & unique_name )
       {
-         Collection<Object> collection(objects,unique_name);
-         t_any_[unique_name] = nullptr;
-         c_any_[unique_name] = std::shared_ptr< Collection<Object> > ( new Collection<Object>(collection) );
-         std::shared_ptr< Collection<Object> > ret = boost::any_cast< std::shared_ptr< Collection<Object> > > (c_any_[unique_name]);
-         return ret;
+         return this->addCollection(Collection<Object>(objects,unique_name));
+      }
+      
+      template <class Object>
+      std::shared_ptr< Collection<Object> >  Analysis::addCollection(std::vector<Object> && objects , const std::string & unique_name )
+      {
+         return this->addCollection(Collection<Object>(std::move(objects),unique_name));
       }
       
       template <class Object>
       std::shared_ptr< Collection<Object> >  Analysis::collection(const std::string & unique_name)
       {
-         std::shared_ptr< Collection<Object> > ret = boost::any_cast< std::shared_ptr< Collection<Object> > > (c_any_[unique_name]);
-         return ret;
+         return this->collection(this->handle<Object>(unique_name));
+      }
+      
+      template <class Object>
+      std::shared_ptr< Collection<Object> >  Analysis::collection(const CollectionHandle<Object> & handle)
+      {
+         if ( ! handle.valid() ) return nullptr;
+         this->stage_(handle.index);
+         return std::static_pointer_cast< Collection<Object> > (slots_[handle.index].collection);
+      }
+      
+      template <class Object>
+      std::shared_ptr<void>  Analysis::treeCollection_(Slot & slot)
+      {
+         // also called from the reader thread, so only the tree of the slot is used
+         auto tree = std::static_pointer_cast< PhysicsObjectTree<Object> > (slot.tree);
+         // the storage of the collection of the previous event is reused if nobody else holds it,
+         // also not a collection kept by dependsOn, e.g. pointed into by associated partons
+         if ( ! pipeline_ && slot.collection && slot.collection.use_count() == 1 )
+            tree -> recycle(static_cast< Collection<Object> * >(slot.collection.get()) -> release());
+         return std::make_shared< Collection<Object> >(tree -> collection());
       }
       //--
       template <class Object1, class Object2>
       void Analysis::match(const std::string & collection, const std::string & match_collection, const float & deltaR)
       {
-         auto o1 = boost::any_cast< std::shared_ptr< Collection<Object1> > > (c_any_[collection]);
-         auto o2 = boost::any_cast< std::shared_ptr< Collection<Object2> > > (c_any_[match_collection]);
-         o1->matchTo(o2->vectorCandidates(),o2->name(), deltaR);
+         this->match(this->handle<Object1>(collection), this->handle<Object2>(match_collection), deltaR);
       }
       //--
       template <class Object1, class Object2>
@@ -309,6 +551,17 @@ namespace analysis {
          for ( auto & mc : match_collections )
             this->match<Object1,Object2>(collection, mc, deltaR);
       }
+      //--
+      template <class Object1, class Object2>
+      void Analysis::match(const CollectionHandle<Object1> & collection, const CollectionHandle<Object2> & match_collection, const float & deltaR)
+      {
+         auto o1 = this->collection(collection);
+         auto o2 = this->collection(match_collection);
+         if ( ! o1 || ! o2 ) return;
+         // the matched objects point into o2
+         o1->dependsOn(o2);
+         o1->matchTo(o2->candidates(),o2->name(), deltaR);
+      }
 
       template<class Object> void Analysis::defaultCollection(const std::string & unique_name)
       { 
@@ -329,11 +582,19 @@ namespace analysis {
       
 
       inline int   Analysis::numberEvents() { return nevents_;   }
-      inline int   Analysis::size()         { return nevents_;   }
+      inline int   Analysis::size()         { return last_ - first_; }
+      inline int   Analysis::rangeSize()    { return last_ - rangeFirst_; }
+      inline int   Analysis::firstEvent()   { return first_;     }
+      inline int   Analysis::lastEvent()    { return last_;      }
+      inline FileManager * Analysis::fileManager() { return files_; }
       inline int   Analysis::event()        { return event_;     }
       inline int   Analysis::run()          { return run_  ;     }
       inline int   Analysis::lumiSection()  { return lumi_ ;     }
       inline bool  Analysis::isMC()         { return is_mc_ ;    }
+      inline bool  Analysis::pipeline()     { return pipeline_;  }
+      inline bool  Analysis::stagedReading(){ return stagedReading_; }
+      inline double Analysis::checkpointElapsed() { return checkpointElapsed_; }
+      inline RandomStream Analysis::randomStream(const std::string & collection, const int & variation) { return RandomStream(run_, lumi_, event_, collection, variation); }
       
       inline int   Analysis::nPileup()      { return n_pu_;      }
       inline float Analysis::nTruePileup()  { return n_true_pu_; }
@@ -348,7 +609,7 @@ namespace analysis {
       inline void Analysis::btagEfficienciesAlgo(const std::string & algo )      { btageff_algo_    = algo; }
       inline void Analysis::btagEfficienciesFlavour(const std::string & flavour) { btageff_flavour_ = flavour; }
       
-      inline std::string Analysis::fileFullName()     { return std::string(t_event_ -> GetFile() -> GetName()) ;    }
+      inline std::string Analysis::fileFullName()     { return files_ -> fileName(files_ -> fileIndex(entry_)) ;    }
       
 //      inline std::string Analysis::getGenParticleCollection() { return genParticleCollection_; }
 
@@ -34,6 +34,8 @@
 namespace analysis {
    namespace tools {
 
+      class CandidateView;
+
       class Candidate {
          typedef std::vector<Candidate> Candidates;
          public:
@@ -94,6 +96,9 @@ namespace analysis {
            /// function to match this candidate to another object from a list of pointers with a name
            virtual bool matchTo(const std::vector<Candidate> * cands, const std::string & name, const float & deltaR = 0.5);
            virtual bool matchTo(const std::vector<Candidate> * cands, const std::string & name, const float & delta_pT, const float & deltaR);
+           /// function to match this candidate to the nearest object of a view, e.g. of a collection, with a name
+           virtual bool matchTo(const CandidateView & cands, const std::string & name, const float & deltaR = 0.5);
+           virtual bool matchTo(const CandidateView & cands, const std::string & name, const float & delta_pT, const float & deltaR);
            /// returns the pointer to the matched candidate object
            const Candidate * matched(const std::string & name);
            /// returns the pointer to the matched candidate object
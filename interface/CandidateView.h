@@ -0,0 +1,154 @@
+#ifndef Analysis_Core_CandidateView_h
+#define Analysis_Core_CandidateView_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      CandidateView
+//
+/**\class CandidateView CandidateView.h Analysis/Core/interface/CandidateView.h
+
+ Description: Non-owning views of the objects of a collection
+
+ Implementation:
+     ObjectView<Object> is a span over contiguous objects, e.g. those of a
+     Collection. CandidateView sees contiguous objects of any type deriving
+     from Candidate as candidates, stepping over them with the size of the
+     actual type, so that no sliced copies are needed and pointers to its
+     elements point to the real objects. Views do not own the objects; they
+     are valid as long as the objects are not destroyed or moved.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:38:46 GMT
+//
+//
+
+// system include files
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+//
+// user include files
+#include "Analysis/Core/interface/Candidate.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class CandidateView {
+         public:
+            class const_iterator {
+               public:
+                  const_iterator(const char * p, const size_t & stride) : p_(p), stride_(stride) {}
+                  const Candidate & operator*()  const { return *reinterpret_cast<const Candidate *>(p_); }
+                  const Candidate * operator->() const { return  reinterpret_cast<const Candidate *>(p_); }
+                  const_iterator &  operator++()       { p_ += stride_; return *this; }
+                  bool operator==(const const_iterator & it) const { return p_ == it.p_; }
+                  bool operator!=(const const_iterator & it) const { return p_ != it.p_; }
+               private:
+                  const char * p_;
+                  size_t stride_;
+            };
+
+            /// empty view
+            CandidateView();
+            /// view of the objects of a vector, seen as candidates
+            template <class Object>
+            CandidateView(const std::vector<Object> & objects);
+            /// view of size objects starting at first, separated by stride bytes
+            CandidateView(const Candidate * first, const size_t & size, const size_t & stride);
+
+            size_t size()  const;
+            bool   empty() const;
+            const Candidate & operator[](const size_t & i) const;
+            /// as operator[], throws std::out_of_range
+            const Candidate & at(const size_t & i) const;
+            const_iterator begin() const;
+            const_iterator end()   const;
+
+         private:
+            const char * data_;
+            size_t size_;
+            size_t stride_;
+      };
+
+      template <class Object>
+      class ObjectView {
+         public:
+            typedef const Object * const_iterator;
+
+            /// empty view
+            ObjectView();
+            /// view of the objects of a vector
+            ObjectView(const std::vector<Object> & objects);
+            /// view of size objects starting at first
+            ObjectView(const Object * first, const size_t & size);
+
+            size_t size()  const;
+            bool   empty() const;
+            const Object & operator[](const size_t & i) const;
+            /// as operator[], throws std::out_of_range
+            const Object & at(const size_t & i) const;
+            const_iterator begin() const;
+            const_iterator end()   const;
+            /// the same objects seen as candidates
+            CandidateView candidates() const;
+
+         private:
+            const Object * data_;
+            size_t size_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline CandidateView::CandidateView() : data_(nullptr), size_(0), stride_(sizeof(Candidate)) {}
+      inline CandidateView::CandidateView(const Candidate * first, const size_t & size, const size_t & stride) :
+         data_(reinterpret_cast<const char *>(first)), size_(first ? size : 0), stride_(stride) {}
+      template <class Object>
+      inline CandidateView::CandidateView(const std::vector<Object> & objects) :
+         data_(objects.empty() ? nullptr : reinterpret_cast<const char *>(static_cast<const Candidate *>(objects.data()))),
+         size_(objects.size()), stride_(sizeof(Object))
+      {
+         static_assert(std::is_base_of<Candidate,Object>::value, "CandidateView of objects not deriving from Candidate");
+      }
+
+      inline size_t CandidateView::size()  const { return size_; }
+      inline bool   CandidateView::empty() const { return size_ == 0; }
+      inline const Candidate & CandidateView::operator[](const size_t & i) const { return *reinterpret_cast<const Candidate *>(data_ + i*stride_); }
+      inline const Candidate & CandidateView::at(const size_t & i) const
+      {
+         if ( i >= size_ ) throw std::out_of_range("CandidateView::at");
+         return (*this)[i];
+      }
+      inline CandidateView::const_iterator CandidateView::begin() const { return const_iterator(data_, stride_); }
+      inline CandidateView::const_iterator CandidateView::end()   const { return const_iterator(data_ + size_*stride_, stride_); }
+
+      template <class Object> inline ObjectView<Object>::ObjectView() : data_(nullptr), size_(0) {}
+      template <class Object> inline ObjectView<Object>::ObjectView(const std::vector<Object> & objects) : data_(objects.data()), size_(objects.size()) {}
+      template <class Object> inline ObjectView<Object>::ObjectView(const Object * first, const size_t & size) : data_(first), size_(first ? size : 0) {}
+
+      template <class Object> inline size_t ObjectView<Object>::size()  const { return size_; }
+      template <class Object> inline bool   ObjectView<Object>::empty() const { return size_ == 0; }
+      template <class Object> inline const Object & ObjectView<Object>::operator[](const size_t & i) const { return data_[i]; }
+      template <class Object> inline const Object & ObjectView<Object>::at(const size_t & i) const
+      {
+         if ( i >= size_ ) throw std::out_of_range("ObjectView::at");
+         return data_[i];
+      }
+      template <class Object> inline typename ObjectView<Object>::const_iterator ObjectView<Object>::begin() const { return data_; }
+      template <class Object> inline typename ObjectView<Object>::const_iterator ObjectView<Object>::end()   const { return data_ + size_; }
+      template <class Object> inline CandidateView ObjectView<Object>::candidates() const
+      {
+         return CandidateView(data_, size_, sizeof(Object));
+      }
+
+   }
+}
+
+#endif  // Analysis_Core_CandidateView_h
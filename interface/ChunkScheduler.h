@@ -0,0 +1,81 @@
+#ifndef Analysis_Core_ChunkScheduler_h
+#define Analysis_Core_ChunkScheduler_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      ChunkScheduler
+//
+/**\class ChunkScheduler ChunkScheduler.cc Analysis/Core/src/ChunkScheduler.cc
+
+ Description: Work-stealing queues of cluster-sized chunks of events
+
+ Implementation:
+     The events are split into chunks, one per cluster of the event tree,
+     across all the input files. Each worker gets a queue with a contiguous
+     block of chunks, so that it mostly stays in the same files. A worker
+     takes chunks from the front of its own queue and, once it is empty,
+     steals from the back of the longest queue of the other workers, so
+     that all workers finish within about one chunk of each other.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:15:30 GMT
+//
+//
+
+// system include files
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+//
+// user include files
+
+#include "Analysis/Core/interface/FileManager.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      typedef std::pair<Long64_t,Long64_t> Chunk;   // global entries [first,last)
+
+      class ChunkScheduler {
+         public:
+            /// constructor from the input files, the range of global entries [first,last) and the number of workers
+            ChunkScheduler(FileManager * files, const Long64_t & first, const Long64_t & last, const int & workers);
+           ~ChunkScheduler();
+
+            /// gets the next chunk of a worker, stealing it from the others if needed; returns false when all are done
+            bool next(const int & worker, Chunk & chunk);
+            /// returns the number of chunks
+            int  size();
+            /// returns the number of chunks stolen by a worker
+            int  stolen(const int & worker);
+
+            // ----------member data ---------------------------
+         protected:
+            std::vector< std::deque<Chunk> > queues_;
+            std::vector< std::unique_ptr<std::mutex> > mutexes_;
+            std::vector<int> stolen_;
+            std::atomic<int> remaining_;
+            int nchunks_;
+
+         private:
+
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline int ChunkScheduler::size()                        { return nchunks_; }
+      inline int ChunkScheduler::stolen(const int & worker)    { return stolen_.at(worker); }
+
+   }
+}
+
+#endif  // Analysis_Core_ChunkScheduler_h
@@ -22,12 +22,16 @@
 // system include files
 #include <memory>
 #include <vector>
+#include <algorithm>
 // 
 // user include files
 #include "Analysis/Core/interface/Candidate.h"
+#include "Analysis/Core/interface/CandidateView.h"
+#include "Analysis/Core/interface/CollectionView.h"
 #include "Analysis/Core/interface/Jet.h"
 #include "Analysis/Core/interface/TriggerObject.h"
 #include "Analysis/Core/interface/GenParticle.h"
+#include "Analysis/Core/interface/RandomStream.h"
 
 //
 // class declaration
@@ -44,14 +48,28 @@ namespace analysis {
          public:
             Collection();
             Collection(const Objects & objects, const std::string & name_ = "");
+            /// constructor taking over the objects without copying them
+            Collection(Objects && objects, const std::string & name_ = "");
+            Collection(const Collection & collection) = default;
+            Collection(Collection && collection) = default;
+            Collection & operator=(const Collection & collection) = default;
+            Collection & operator=(Collection && collection) = default;
            ~Collection();
            
            int size();
            void setSize(const int & size);
            Object & at(const int & index);
            void add(const Object & object);
+           void add(Object && object);
+           /// moves the objects out, e.g. to reuse their storage, leaving the collection empty
+           Objects release();
+           /// keeps a collection the objects point into, e.g. that of the associated partons or of the matched
+           /// objects, as long as this one; Analysis does not reuse the storage of a collection that is still held.
+           /// Not if the other collection keeps this one already, which would keep both forever.
+           template <class Other>
+           void dependsOn(const std::shared_ptr< Collection<Other> > & collection);
            
-           void matchTo( const std::vector<Candidate>* vectorcandidates, const std::string & name , const float & deltaR = 0.5 );
+           void matchTo( const CandidateView & candidates, const std::string & name , const float & deltaR = 0.5 );
            void matchTo( const Collection<Candidate> & collection, const float & delta_pT, const float & deltaR);
            void matchTo( const Collection<Jet> & collection, const float & delta_pT, const float & deltaR);
            void matchTo( const Collection<Candidate> & collection, const float & deltaR = 0.5 );
@@ -59,9 +77,16 @@ namespace analysis {
            void matchTo( const std::shared_ptr<Collection<TriggerObject> > collection, const float & deltaR = 0.5 );
 
            void smearTo( const Collection<Jet> & collection, const double & n_sigma = 0 );
+           /// as above with the random numbers of the stream of this collection in the event,
+           /// reproducible whatever the order, thread or shard the events are processed in
+           void smearTo( const Collection<Jet> & collection, const RandomStream & random, const double & n_sigma = 0 );
 
-           std::vector< std::shared_ptr<Object> > vector();
-           std::vector<Candidate>* vectorCandidates() const;
+           /// non-owning view of the objects, valid until the collection is modified or destroyed
+           ObjectView<Object> objects() const;
+           /// the objects seen as candidates, e.g. to be matched to; same validity as objects()
+           CandidateView candidates() const;
+           /// view of all objects to be filtered, sorted or reduced to the top k, without copying them
+           CollectionView<Object> view() const;
            
            std::string name() const;
            
@@ -71,10 +96,13 @@ namespace analysis {
          protected:
                
          private:
+            void smear_( const Collection<Jet> & collection, const double & n_sigma, const RandomStream * random );
+            
             Objects objects_;
-            mutable std::vector<Candidate> candidates_; // maybe not the best idea but need to make code work
             int size_;
             std::string name_;
+            std::vector< std::shared_ptr<const void> > dependsOn_;
+            template <class Other> friend class Collection;
 
       };
       // ===============================================
@@ -85,10 +113,21 @@ namespace analysis {
       template <class Object> inline int         Collection<Object>::size()                { return size_; }
       template <class Object> inline Object  &   Collection<Object>::at(const int & index) { return objects_.at(index); }
       template <class Object> inline std::string Collection<Object>::name() const          { return name_; }
+      template <class Object> inline ObjectView<Object> Collection<Object>::objects() const { return ObjectView<Object>(objects_); }
+      template <class Object> inline CollectionView<Object> Collection<Object>::view() const { return CollectionView<Object>(this->objects()); }
 
       // Sets
       template <class Object> inline void   Collection<Object>::add(const Object & object) { objects_.push_back(object); ++size_;  }
+      template <class Object> inline void   Collection<Object>::add(Object && object)      { objects_.push_back(std::move(object)); ++size_;  }
       template <class Object> inline void   Collection<Object>::setSize(const int & size) { size_ = size; }
+      template <class Object> template <class Other>
+      inline void Collection<Object>::dependsOn(const std::shared_ptr< Collection<Other> > & collection)
+      {
+         if ( ! collection ) return;
+         for ( auto & c : collection -> dependsOn_ )
+            if ( c.get() == static_cast<const void *>(this) ) return;
+         if ( std::find(dependsOn_.begin(),dependsOn_.end(),collection) == dependsOn_.end() ) dependsOn_.push_back(collection);
+      }
 
    }
 }
@@ -0,0 +1,209 @@
+#ifndef Analysis_Core_CollectionView_h
+#define Analysis_Core_CollectionView_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      CollectionView
+//
+/**\class CollectionView CollectionView.h Analysis/Core/interface/CollectionView.h
+
+ Description: Selected and ordered view of the objects of a collection
+
+ Implementation:
+     A permutation of indices over the objects of a Collection. Filtering,
+     sorting and top-k selection only move the indices, the objects are
+     neither copied nor moved, and the operations can be chained, e.g.
+        auto jets = collection->view().filter(loose).leading(4);
+     As the other views, it is valid as long as the collection is not
+     modified or destroyed.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:42:12 GMT
+//
+//
+
+// system include files
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+//
+// user include files
+#include "Analysis/Core/interface/CandidateView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      template <class Object>
+      class CollectionView {
+         public:
+            typedef std::vector<unsigned int> Indices;
+
+            class const_iterator {
+               public:
+                  const_iterator(const Object * data, Indices::const_iterator it) : data_(data), it_(it) {}
+                  const Object & operator*()  const { return data_[*it_]; }
+                  const Object * operator->() const { return &data_[*it_]; }
+                  const_iterator & operator++()     { ++it_; return *this; }
+                  bool operator==(const const_iterator & it) const { return it_ == it.it_; }
+                  bool operator!=(const const_iterator & it) const { return it_ != it.it_; }
+               private:
+                  const Object * data_;
+                  Indices::const_iterator it_;
+            };
+
+            /// empty view
+            CollectionView();
+            /// view of all objects, in their original order
+            CollectionView(const ObjectView<Object> & objects);
+
+            size_t size()  const;
+            bool   empty() const;
+            const Object & operator[](const size_t & i) const;
+            /// as operator[], throws std::out_of_range
+            const Object & at(const size_t & i) const;
+            /// index in the collection of the i-th object of the view
+            unsigned int index(const size_t & i) const;
+            const Indices & indices() const;
+            const_iterator begin() const;
+            const_iterator end()   const;
+
+            /// keeps the objects passing the predicate, preserving their order
+            template <class Predicate> CollectionView & filter(Predicate pred);
+            /// keeps the objects at the given positions of the view, in the order of the positions
+            CollectionView & select(const std::vector<unsigned int> & positions);
+            /// orders the objects with a comparison of two objects
+            template <class Compare> CollectionView & sort(Compare comp);
+            /// orders only the first k objects, the others stay unordered after them
+            template <class Compare> CollectionView & partialSort(const size_t & k, Compare comp);
+            /// keeps only the first k objects in the order given by the comparison
+            template <class Compare> CollectionView & top(const size_t & k, Compare comp);
+            /// pt ordering, descending
+            CollectionView & sortByPt();
+            CollectionView & partialSortByPt(const size_t & k);
+            /// the k objects of largest pt, pt ordered
+            CollectionView & leading(const size_t & k);
+
+            /// number of objects passing the predicate
+            template <class Predicate> size_t count(Predicate pred) const;
+            /// number of objects with pt >= ptmin; a binary search if the view is pt ordered
+            size_t countPtMin(const float & ptmin) const;
+
+         private:
+            const Object * data_;
+            Indices indices_;
+            bool ptOrdered_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <class Object> inline CollectionView<Object>::CollectionView() : data_(nullptr), ptOrdered_(false) {}
+      template <class Object> inline CollectionView<Object>::CollectionView(const ObjectView<Object> & objects) :
+         data_(objects.begin()), indices_(objects.size()), ptOrdered_(false)
+      {
+         for ( size_t i = 0 ; i < indices_.size() ; ++i ) indices_[i] = i;
+      }
+
+      // Gets
+      template <class Object> inline size_t CollectionView<Object>::size()  const { return indices_.size(); }
+      template <class Object> inline bool   CollectionView<Object>::empty() const { return indices_.empty(); }
+      template <class Object> inline const Object & CollectionView<Object>::operator[](const size_t & i) const { return data_[indices_[i]]; }
+      template <class Object> inline const Object & CollectionView<Object>::at(const size_t & i) const
+      {
+         if ( i >= indices_.size() ) throw std::out_of_range("CollectionView::at");
+         return data_[indices_[i]];
+      }
+      template <class Object> inline unsigned int CollectionView<Object>::index(const size_t & i) const { return indices_.at(i); }
+      template <class Object> inline const std::vector<unsigned int> & CollectionView<Object>::indices() const { return indices_; }
+      template <class Object> inline typename CollectionView<Object>::const_iterator CollectionView<Object>::begin() const { return const_iterator(data_, indices_.begin()); }
+      template <class Object> inline typename CollectionView<Object>::const_iterator CollectionView<Object>::end()   const { return const_iterator(data_, indices_.end()); }
+
+      // Operations
+      template <class Object> template <class Predicate>
+      inline CollectionView<Object> & CollectionView<Object>::filter(Predicate pred)
+      {
+         const Object * data = data_;
+         indices_.erase(std::remove_if(indices_.begin(), indices_.end(),
+                                       [data,&pred](const unsigned int & i) { return ! pred(data[i]); }),
+                        indices_.end());
+         return *this;
+      }
+      template <class Object> inline CollectionView<Object> & CollectionView<Object>::select(const std::vector<unsigned int> & positions)
+      {
+         Indices indices(positions.size());
+         for ( size_t i = 0 ; i < positions.size() ; ++i ) indices[i] = indices_.at(positions[i]);
+         indices_.swap(indices);
+         ptOrdered_ = false;
+         return *this;
+      }
+      template <class Object> template <class Compare>
+      inline CollectionView<Object> & CollectionView<Object>::sort(Compare comp)
+      {
+         const Object * data = data_;
+         std::sort(indices_.begin(), indices_.end(),
+                   [data,&comp](const unsigned int & i, const unsigned int & j) { return comp(data[i], data[j]); });
+         ptOrdered_ = false;
+         return *this;
+      }
+      template <class Object> template <class Compare>
+      inline CollectionView<Object> & CollectionView<Object>::partialSort(const size_t & k, Compare comp)
+      {
+         const Object * data = data_;
+         auto middle = indices_.begin() + std::min(k, indices_.size());
+         std::partial_sort(indices_.begin(), middle, indices_.end(),
+                           [data,&comp](const unsigned int & i, const unsigned int & j) { return comp(data[i], data[j]); });
+         ptOrdered_ = false;
+         return *this;
+      }
+      template <class Object> template <class Compare>
+      inline CollectionView<Object> & CollectionView<Object>::top(const size_t & k, Compare comp)
+      {
+         this -> partialSort(k, comp);
+         if ( indices_.size() > k ) indices_.resize(k);
+         return *this;
+      }
+      template <class Object> inline CollectionView<Object> & CollectionView<Object>::sortByPt()
+      {
+         this -> sort([](const Object & o1, const Object & o2) { return o1.pt() > o2.pt(); });
+         ptOrdered_ = true;
+         return *this;
+      }
+      template <class Object> inline CollectionView<Object> & CollectionView<Object>::partialSortByPt(const size_t & k)
+      {
+         return this -> partialSort(k, [](const Object & o1, const Object & o2) { return o1.pt() > o2.pt(); });
+      }
+      template <class Object> inline CollectionView<Object> & CollectionView<Object>::leading(const size_t & k)
+      {
+         this -> top(k, [](const Object & o1, const Object & o2) { return o1.pt() > o2.pt(); });
+         ptOrdered_ = true;
+         return *this;
+      }
+
+      template <class Object> template <class Predicate>
+      inline size_t CollectionView<Object>::count(Predicate pred) const
+      {
+         size_t n = 0;
+         for ( auto & i : indices_ )
+            if ( pred(data_[i]) ) ++n;
+         return n;
+      }
+      template <class Object> inline size_t CollectionView<Object>::countPtMin(const float & ptmin) const
+      {
+         if ( ! ptOrdered_ )
+            return this -> count([&ptmin](const Object & o) { return o.pt() >= ptmin; });
+         const Object * data = data_;
+         auto it = std::partition_point(indices_.begin(), indices_.end(),
+                                        [data,&ptmin](const unsigned int & i) { return data[i].pt() >= ptmin; });
+         return std::distance(indices_.begin(), it);
+      }
+
+   }
+}
+
+#endif  // Analysis_Core_CollectionView_h
@@ -0,0 +1,198 @@
+#ifndef Analysis_Core_Combinatorics_h
+#define Analysis_Core_Combinatorics_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      Combinatorics
+//
+/**\class Combinatorics Combinatorics.cc Analysis/Core/src/Combinatorics.cc
+
+ Description: Combinations of the leading objects of a collection and their kinematics
+
+ Implementation:
+     The momenta of the leading n objects of a view are copied into columns
+     (structure of arrays). The invariant mass, deltaR, deltaEta and deltaPhi
+     of all pairs are computed at once by loops over these columns, without
+     indirection; pairs are numbered (0,1),(0,2)...(0,n-1),(1,2)...
+     combinations() enumerates the k-combinations in lexicographic order and
+     does not extend a partial combination rejected by a predicate.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:48:31 GMT
+//
+//
+
+// system include files
+#include <vector>
+#include <utility>
+//
+// user include files
+#include "Analysis/Core/interface/Utils.h"
+#include "Analysis/Core/interface/CandidateView.h"
+#include "Analysis/Core/interface/CollectionView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class Combinatorics {
+         public:
+            Combinatorics();
+            /// the first n objects of a view, e.g. the leading ones after leading(n); all if n < 0
+            template <class Object>
+            Combinatorics(const CollectionView<Object> & objects, const int & n = -1);
+            template <class Object>
+            Combinatorics(const ObjectView<Object> & objects, const int & n = -1);
+           ~Combinatorics();
+
+            /// number of objects
+            size_t size() const;
+            /// number of pairs, n(n-1)/2
+            size_t nPairs() const;
+            /// index of the pair (i,j), i != j
+            size_t pair(const size_t & i, const size_t & j) const;
+            /// objects of the p-th pair
+            std::pair<size_t,size_t> pairObjects(const size_t & p) const;
+
+            // Pair kinematics, indexed by pair
+            const std::vector<float> & pairMass()     const;
+            const std::vector<float> & pairDeltaR()   const;
+            const std::vector<float> & pairDeltaEta() const;
+            const std::vector<float> & pairDeltaPhi() const;
+            float mass    (const size_t & i, const size_t & j) const;
+            float deltaR  (const size_t & i, const size_t & j) const;
+            /// eta_i - eta_j
+            float deltaEta(const size_t & i, const size_t & j) const;
+            /// phi_i - phi_j in [-pi,pi)
+            float deltaPhi(const size_t & i, const size_t & j) const;
+            /// invariant mass of any number of objects
+            float mass(const std::vector<size_t> & objects) const;
+            /// smallest deltaR of all pairs (large if less than two objects)
+            float minDeltaR() const;
+
+            /// calls function(objects) for each k-combination of the objects. After adding an object to
+            /// a partial combination accept(objects) is called, and the combination is dropped if false,
+            /// e.g. [&](const std::vector<size_t> & c) { return c.size() < 2 || comb.deltaR(c[0],c.back()) > 1; }
+            /// Returns the number of combinations given to function.
+            template <class Accept, class Function>
+            size_t combinations(const size_t & k, Accept accept, Function function) const;
+            /// all k-combinations
+            template <class Function>
+            size_t combinations(const size_t & k, Function function) const;
+
+         private:
+            void add_(const Candidate & candidate);
+            void kinematics_();
+
+            // columns of the objects
+            std::vector<float> px_;
+            std::vector<float> py_;
+            std::vector<float> pz_;
+            std::vector<float> e_;
+            std::vector<float> eta_;
+            std::vector<float> phi_;
+
+            // columns of the pairs
+            std::vector<unsigned short> first_;
+            std::vector<unsigned short> second_;
+            std::vector<float> mass_;
+            std::vector<float> deltaR_;
+            std::vector<float> deltaEta_;
+            std::vector<float> deltaPhi_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <class Object>
+      Combinatorics::Combinatorics(const CollectionView<Object> & objects, const int & n)
+      {
+         size_t size = n < 0 ? objects.size() : std::min(objects.size(), (size_t) n);
+         for ( size_t i = 0 ; i < size ; ++i ) this -> add_(objects[i]);
+         this -> kinematics_();
+      }
+      template <class Object>
+      Combinatorics::Combinatorics(const ObjectView<Object> & objects, const int & n)
+      {
+         size_t size = n < 0 ? objects.size() : std::min(objects.size(), (size_t) n);
+         for ( size_t i = 0 ; i < size ; ++i ) this -> add_(objects[i]);
+         this -> kinematics_();
+      }
+
+      inline size_t Combinatorics::size()   const { return e_.size(); }
+      inline size_t Combinatorics::nPairs() const { return mass_.size(); }
+      inline size_t Combinatorics::pair(const size_t & i, const size_t & j) const
+      {
+         // pairs before those starting with a: a*n - a(a+1)/2
+         size_t a = std::min(i,j);
+         size_t b = std::max(i,j);
+         return a*e_.size() - a*(a+1)/2 + (b - a - 1);
+      }
+      inline std::pair<size_t,size_t> Combinatorics::pairObjects(const size_t & p) const { return std::make_pair(first_[p], second_[p]); }
+
+      inline const std::vector<float> & Combinatorics::pairMass()     const { return mass_;     }
+      inline const std::vector<float> & Combinatorics::pairDeltaR()   const { return deltaR_;   }
+      inline const std::vector<float> & Combinatorics::pairDeltaEta() const { return deltaEta_; }
+      inline const std::vector<float> & Combinatorics::pairDeltaPhi() const { return deltaPhi_; }
+      inline float Combinatorics::mass  (const size_t & i, const size_t & j) const { return mass_[this->pair(i,j)];   }
+      inline float Combinatorics::deltaR(const size_t & i, const size_t & j) const { return deltaR_[this->pair(i,j)]; }
+      inline float Combinatorics::deltaEta(const size_t & i, const size_t & j) const
+      {
+         float deta = deltaEta_[this->pair(i,j)];
+         return i < j ? deta : -deta;
+      }
+      inline float Combinatorics::deltaPhi(const size_t & i, const size_t & j) const
+      {
+         float dphi = deltaPhi_[this->pair(i,j)];
+         return i < j ? dphi : -dphi;
+      }
+
+      template <class Accept, class Function>
+      size_t Combinatorics::combinations(const size_t & k, Accept accept, Function function) const
+      {
+         size_t n = this -> size();
+         if ( k == 0 || k > n ) return 0;
+         size_t ncomb = 0;
+         std::vector<size_t> objects;
+         objects.reserve(k);
+         objects.push_back(0);
+         while ( ! objects.empty() )
+         {
+            // extend an accepted partial combination, otherwise move to the next object at this depth
+            bool extend = accept(static_cast<const std::vector<size_t> &>(objects));
+            if ( extend && objects.size() == k )
+            {
+               function(static_cast<const std::vector<size_t> &>(objects));
+               ++ncomb;
+               extend = false;
+            }
+            if ( extend )
+            {
+               objects.push_back(objects.back()+1);
+               continue;
+            }
+            // next candidate at this depth, leaving room for the remaining objects
+            while ( ! objects.empty() )
+            {
+               ++objects.back();
+               if ( objects.back() + (k - objects.size()) < n ) break;
+               objects.pop_back();
+            }
+         }
+         return ncomb;
+      }
+      template <class Function>
+      size_t Combinatorics::combinations(const size_t & k, Function function) const
+      {
+         return this -> combinations(k, [](const std::vector<size_t> &) { return true; }, function);
+      }
+
+   }
+}
+
+#endif  // Analysis_Core_Combinatorics_h
@@ -0,0 +1,110 @@
+#ifndef Analysis_Core_CompositeCandidate_h
+#define Analysis_Core_CompositeCandidate_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      CompositeCandidate
+//
+/**\class CompositeCandidate CompositeCandidate.cc Analysis/Core/src/CompositeCandidate.cc
+
+ Description: Candidate made of daughters in a collection, e.g. a Higgs candidate from two jets
+
+ Implementation:
+     The daughters are not copied, the candidate keeps their indices in the
+     collection and pointers to them, valid as long as the collection is not
+     modified or destroyed. The momentum components of the daughters are summed
+     once; the mass and the pt are computed when first asked and then cached.
+     Being a Candidate, it can be matched and used in deltaR like any other.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:49:23 GMT
+//
+//
+
+// system include files
+#include <vector>
+//
+// user include files
+#include "Analysis/Core/interface/Candidate.h"
+#include "Analysis/Core/interface/CollectionView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class CompositeCandidate : public Candidate {
+         public:
+            CompositeCandidate();
+            /// from the objects of a view at the given positions in the view
+            template <class Object>
+            CompositeCandidate(const CollectionView<Object> & objects, const std::vector<size_t> & daughters);
+            /// from the first n objects of a view, e.g. the two leading jets
+            template <class Object>
+            CompositeCandidate(const CollectionView<Object> & objects, const size_t & n);
+            /// from the objects of a collection at the given indices
+            template <class Object>
+            CompositeCandidate(const ObjectView<Object> & objects, const std::vector<size_t> & daughters);
+           ~CompositeCandidate();
+
+            size_t nDaughters() const;
+            /// the i-th daughter
+            const Candidate * daughter(const size_t & i) const;
+            /// index of the i-th daughter in its collection
+            unsigned int daughterIndex(const size_t & i) const;
+
+            /// the mass, cached
+            float m()    const;
+            float mass() const;
+            /// the transverse momentum, cached
+            float pt()   const;
+
+         protected:
+            void addDaughter_(const Candidate & daughter, const unsigned int & index);
+            void sum_();
+
+            std::vector<const Candidate *> daughters_;
+            std::vector<unsigned int> indices_;
+            mutable float m_;
+            mutable float pt_;
+            mutable bool  mCached_;
+            mutable bool  ptCached_;
+
+         private:
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <class Object>
+      CompositeCandidate::CompositeCandidate(const CollectionView<Object> & objects, const std::vector<size_t> & daughters)
+      {
+         for ( auto & d : daughters ) this -> addDaughter_(objects[d], objects.index(d));
+         this -> sum_();
+      }
+      template <class Object>
+      CompositeCandidate::CompositeCandidate(const CollectionView<Object> & objects, const size_t & n)
+      {
+         for ( size_t d = 0 ; d < n && d < objects.size() ; ++d ) this -> addDaughter_(objects[d], objects.index(d));
+         this -> sum_();
+      }
+      template <class Object>
+      CompositeCandidate::CompositeCandidate(const ObjectView<Object> & objects, const std::vector<size_t> & daughters)
+      {
+         for ( auto & d : daughters ) this -> addDaughter_(objects[d], d);
+         this -> sum_();
+      }
+
+      inline size_t            CompositeCandidate::nDaughters()                    const { return daughters_.size();  }
+      inline const Candidate * CompositeCandidate::daughter(const size_t & i)      const { return daughters_.at(i);   }
+      inline unsigned int      CompositeCandidate::daughterIndex(const size_t & i) const { return indices_.at(i);     }
+      inline float             CompositeCandidate::mass()                          const { return this -> m();        }
+
+   }
+}
+
+#endif  // Analysis_Core_CompositeCandidate_h
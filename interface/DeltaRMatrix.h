@@ -0,0 +1,150 @@
+#ifndef Analysis_Core_DeltaRMatrix_h
+#define Analysis_Core_DeltaRMatrix_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      DeltaRMatrix
+//
+/**\class DeltaRMatrix DeltaRMatrix.cc Analysis/Core/src/DeltaRMatrix.cc
+
+ Description: deltaR^2 between the objects of one or two collections, for isolation and overlap removal
+
+ Implementation:
+     The eta and phi of the objects are copied into columns and deltaR^2 is
+     computed row by row with the deltaR2 kernel of Utils.h, in loops without
+     square roots or atan2. For a single collection only the upper
+     triangle is kept, packed as the pairs (0,1),(0,2)...(0,n-1),(1,2)...
+     (the order of Combinatorics); for two collections the full matrix,
+     row major, with a row per object of the first. Cuts are given in deltaR
+     and squared once.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:51:01 GMT
+//
+//
+
+// system include files
+#include <vector>
+#include <algorithm>
+//
+// user include files
+#include "Analysis/Core/interface/Utils.h"
+#include "Analysis/Core/interface/CandidateView.h"
+#include "Analysis/Core/interface/CollectionView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class DeltaRMatrix {
+         public:
+            DeltaRMatrix();
+            /// pairs of the first n objects of a view; all if n < 0
+            template <class Object>
+            DeltaRMatrix(const CollectionView<Object> & objects, const int & n = -1);
+            template <class Object>
+            DeltaRMatrix(const ObjectView<Object> & objects, const int & n = -1);
+            /// each object of rows with each object of columns, e.g. jets and muons
+            template <class Object1, class Object2>
+            DeltaRMatrix(const CollectionView<Object1> & rows, const CollectionView<Object2> & columns);
+            template <class Object1, class Object2>
+            DeltaRMatrix(const ObjectView<Object1> & rows, const ObjectView<Object2> & columns);
+           ~DeltaRMatrix();
+
+            size_t rows()    const;
+            size_t columns() const;
+            /// single collection, only the upper triangle is stored
+            bool   symmetric() const;
+            /// the packed upper triangle or the row major matrix
+            const std::vector<float> & values() const;
+
+            /// deltaR^2 between the objects i and j (0 for i == j of a single collection)
+            float deltaR2(const size_t & i, const size_t & j) const;
+            /// smallest deltaR^2 of the matrix (large if empty)
+            float minDeltaR2() const;
+            /// smallest deltaR^2 of each row object to the (other) objects
+            std::vector<float> minDeltaR2PerObject() const;
+            /// number of (other) objects within dRmax of the i-th row object, e.g. for isolation
+            size_t nWithin(const size_t & i, const float & dRmax) const;
+            /// the row objects with no (other) object within dRmax, e.g. jets not overlapping with muons
+            std::vector<bool> isolated(const float & dRmax) const;
+
+         private:
+            template <class View>
+            static void columns_(const View & objects, const size_t & n, std::vector<float> & eta, std::vector<float> & phi);
+            static void row_(const float & eta, const float & phi, const float * etas, const float * phis, const size_t & n, float * out);
+            void fill_();
+
+            std::vector<float> rowEta_;
+            std::vector<float> rowPhi_;
+            std::vector<float> colEta_;
+            std::vector<float> colPhi_;
+            bool symmetric_;
+            std::vector<float> deltaR2_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <class View>
+      void DeltaRMatrix::columns_(const View & objects, const size_t & n, std::vector<float> & eta, std::vector<float> & phi)
+      {
+         eta.resize(n);
+         phi.resize(n);
+         for ( size_t i = 0 ; i < n ; ++i )
+         {
+            eta[i] = objects[i].eta();
+            phi[i] = objects[i].phi();
+         }
+      }
+      template <class Object>
+      DeltaRMatrix::DeltaRMatrix(const CollectionView<Object> & objects, const int & n) : symmetric_(true)
+      {
+         size_t size = n < 0 ? objects.size() : std::min(objects.size(), (size_t) n);
+         columns_(objects, size, rowEta_, rowPhi_);
+         this -> fill_();
+      }
+      template <class Object>
+      DeltaRMatrix::DeltaRMatrix(const ObjectView<Object> & objects, const int & n) : symmetric_(true)
+      {
+         size_t size = n < 0 ? objects.size() : std::min(objects.size(), (size_t) n);
+         columns_(objects, size, rowEta_, rowPhi_);
+         this -> fill_();
+      }
+      template <class Object1, class Object2>
+      DeltaRMatrix::DeltaRMatrix(const CollectionView<Object1> & rows, const CollectionView<Object2> & columns) : symmetric_(false)
+      {
+         columns_(rows, rows.size(), rowEta_, rowPhi_);
+         columns_(columns, columns.size(), colEta_, colPhi_);
+         this -> fill_();
+      }
+      template <class Object1, class Object2>
+      DeltaRMatrix::DeltaRMatrix(const ObjectView<Object1> & rows, const ObjectView<Object2> & columns) : symmetric_(false)
+      {
+         columns_(rows, rows.size(), rowEta_, rowPhi_);
+         columns_(columns, columns.size(), colEta_, colPhi_);
+         this -> fill_();
+      }
+
+      inline size_t DeltaRMatrix::rows()      const { return rowEta_.size(); }
+      inline size_t DeltaRMatrix::columns()   const { return symmetric_ ? rowEta_.size() : colEta_.size(); }
+      inline bool   DeltaRMatrix::symmetric() const { return symmetric_; }
+      inline const std::vector<float> & DeltaRMatrix::values() const { return deltaR2_; }
+      inline float DeltaRMatrix::deltaR2(const size_t & i, const size_t & j) const
+      {
+         if ( ! symmetric_ ) return deltaR2_[i*colEta_.size() + j];
+         if ( i == j ) return 0;
+         size_t a = std::min(i,j);
+         size_t b = std::max(i,j);
+         return deltaR2_[a*rowEta_.size() - a*(a+1)/2 + (b - a - 1)];
+      }
+
+   }
+}
+
+#endif  // Analysis_Core_DeltaRMatrix_h
@@ -0,0 +1,181 @@
+#ifndef Analysis_Core_FileManager_h
+#define Analysis_Core_FileManager_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      FileManager
+//
+/**\class FileManager FileManager.cc Analysis/Core/src/FileManager.cc
+
+ Description: Keeps a single open TFile per input for all trees of an analysis
+
+ Implementation:
+     The input files are opened one at a time. All the trees of the event
+     loop (event info, trigger results and physics objects) are taken from
+     the current file, so that each file is opened only once while the event
+     loop goes through it. Metadata are read from files opened on their own,
+     which leaves the current file and its trees untouched. The global entry
+     of the event tree is translated into the file index and the local entry
+     within that file.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:00:08 GMT
+//
+//
+
+// system include files
+#include <memory>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+//
+// user include files
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TCollection.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class FileManager {
+         public:
+            /// constructor from the list of files (TFileInfo) and the path to the tree defining the events
+            FileManager(TCollection * fileList, const std::string & eventTree);
+            /// constructor of a manager of the same files as another one, e.g. for a worker thread, with the entries
+            /// and clusters of the other one, so that the files are not opened again to count them; no file is open
+            FileManager(const FileManager & files);
+            /// destructor
+           ~FileManager();
+
+            // Files
+            /// returns the number of input files
+            int  size();
+            /// returns the index of the current file (-1 if none is open)
+            int  index();
+            /// returns the current file
+            TFile * file();
+            /// makes the file with a given index the current one, closing the previous one
+            TFile * file(const int & index);
+            /// returns the name (url) of the file with a given index
+            std::string fileName(const int & index);
+            /// opens the file with a given index on its own, e.g. to read metadata, leaving the current file
+            /// and its trees as they are; the caller closes and deletes it (NULL if it cannot be opened)
+            TFile * openFile(const int & index);
+
+            // Trees
+            /// returns the tree with a given path in the current file (NULL if it does not exist)
+            TTree * tree(const std::string & path);
+            /// returns the tree with a given path in the file with a given index
+            TTree * tree(const int & index, const std::string & path);
+
+            // Entries of the event tree
+            /// returns the total number of entries of the event tree
+            Long64_t entries();
+            /// returns the number of entries of the event tree in the file with a given index
+            Long64_t entries(const int & index);
+            /// returns the global entry number of the first entry in the file with a given index
+            Long64_t offset(const int & index);
+            /// returns the index of the file containing a global entry
+            int  fileIndex(const Long64_t & entry);
+            /// makes current the file containing a global entry and returns the local entry
+            Long64_t entry(const Long64_t & entry);
+            /// returns whether the current file has changed since the previous call to entry()
+            bool newFile();
+            /// returns the size in bytes of the file with a given index
+            Long64_t bytes(const int & index);
+            /// returns the first (local) entry of each cluster of the event tree in the file with a given index
+            const std::vector<Long64_t> & clusters(const int & index);
+            /// returns the range [first,last) of global entries of the k-th of n shards, aligned to the clusters
+            /// of the event tree and balanced on the number of entries or on the size of the files
+            std::pair<Long64_t,Long64_t> shard(const int & k, const int & n, const bool & byBytes = false);
+
+            // Read cache
+            /// enables the TTreeCache of the trees given the cache size in bytes (<= 0 sizes each tree from its branches),
+            /// the number of entries in the learning phase (0 caches only the branches given) and the asynchronous prefetching
+            void cache(const Long64_t & size, const int & learn = 0, const bool & prefetch = false);
+            /// returns whether the read cache is enabled
+            bool cache();
+            /// sets the read cache of a tree of the current file for the branches to be read
+            void cache(TTree * tree, const std::vector<std::string> & branches);
+            /// prints the cache hit rate and the bytes read
+            void cacheReport();
+
+            // Monitoring
+            /// returns the bytes read from all files so far
+            Long64_t bytesRead();
+            /// returns the number of files opened so far
+            int  filesOpened();
+            /// returns the time in seconds spent opening files
+            double fileOpenSeconds();
+
+            // ----------member data ---------------------------
+         protected:
+            std::vector<std::string> fileNames_;
+            std::string eventTree_;
+
+            std::vector<Long64_t> entries_;
+            std::vector<Long64_t> offsets_;
+            Long64_t nentries_;
+            std::vector<Long64_t> bytes_;
+            std::vector< std::vector<Long64_t> > clusters_;   // first (local) entry of each cluster
+            Long64_t shardBoundary_(const int & k, const int & n, const bool & byBytes);
+
+            TFile * file_;
+            int index_;
+            bool newFile_;
+            bool changed_;
+
+            // trees of the current file
+            std::map<std::string, TTree *> trees_;
+
+            // read cache
+            void cacheStats_(Long64_t & bytesRead, Long64_t & readCalls, std::map<std::string, Long64_t> & cacheBytes, std::map<std::string, Long64_t> & noCacheBytes);
+            Long64_t cacheSize_(TTree * tree, const std::vector<std::string> & branches);
+            bool cache_;
+            Long64_t cachesize_;
+            int  cachelearn_;
+            bool cacheprefetch_;
+            std::set<std::string> cached_;   // paths of the cached trees in the current file
+            std::map<std::string, Long64_t> cacheBytes_;
+            std::map<std::string, Long64_t> noCacheBytes_;
+            Long64_t bytesRead_;
+            Long64_t readCalls_;
+
+            // monitoring
+            int    filesOpened_;
+            double fileOpenSeconds_;
+
+         private:
+            FileManager & operator=(const FileManager &) = delete;
+
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline int      FileManager::size()                           { return (int) fileNames_.size(); }
+      inline int      FileManager::index()                          { return index_; }
+      inline TFile *  FileManager::file()                           { return file_;  }
+      inline std::string FileManager::fileName(const int & index)   { return fileNames_.at(index); }
+      inline Long64_t FileManager::entries()                        { return nentries_; }
+      inline Long64_t FileManager::entries(const int & index)       { return entries_.at(index); }
+      inline Long64_t FileManager::offset(const int & index)        { return offsets_.at(index); }
+      inline bool     FileManager::newFile()                        { return newFile_; }
+      inline Long64_t FileManager::bytes(const int & index)         { return bytes_.at(index); }
+      inline const std::vector<Long64_t> & FileManager::clusters(const int & index) { return clusters_.at(index); }
+      inline bool     FileManager::cache()                          { return cache_; }
+      inline int      FileManager::filesOpened()                    { return filesOpened_; }
+      inline double   FileManager::fileOpenSeconds()                { return fileOpenSeconds_; }
+
+   }
+}
+
+#endif  // Analysis_Core_FileManager_h
@@ -40,9 +40,9 @@ namespace analysis {
             void pdgId(const int & pdgId);
             void status(const int & status);
             void higgsDaughter(const bool & higgs_dau);
-            int pdgId();
-            int status();
-            bool higgsDaughter();
+            int pdgId() const;
+            int status() const;
+            bool higgsDaughter() const;
       
          private:
             // ----------member data ---------------------------
@@ -55,9 +55,9 @@ namespace analysis {
       // INLINE IMPLEMENTATIONS
          
       // Gets
-      inline int  GenParticle::pdgId()    { return pdgid_;    }                   
-      inline int  GenParticle::status()   { return status_;    }                   
-      inline bool GenParticle::higgsDaughter()   { return higgs_dau_;    }                   
+      inline int  GenParticle::pdgId()  const  { return pdgid_;    }                   
+      inline int  GenParticle::status() const  { return status_;    }                   
+      inline bool GenParticle::higgsDaughter() const  { return higgs_dau_;    }                   
                 
       // Sets                                                             
       inline void GenParticle::pdgId  (const int & pdgId)  { pdgid_  = pdgId; } 
@@ -0,0 +1,120 @@
+#ifndef Analysis_Core_GenParticleIndex_h
+#define Analysis_Core_GenParticleIndex_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      GenParticleIndex
+//
+/**\class GenParticleIndex GenParticleIndex.cc Analysis/Core/src/GenParticleIndex.cc
+
+ Description: Index of the generated particles of an event by |pdgId| and status
+
+ Implementation:
+     The indices of the particles are sorted once by (|pdgId|, status, index),
+     so that all particles of a |pdgId| are contiguous and, among them, those
+     of a status range too. Queries are binary searches returning ranges of
+     the particles, without scanning the collection, e.g.
+        for ( auto & b : index.withPdg(5).status(71,72) ) ...
+     Within a range the particles are in the order of the collection for
+     each status. The Higgs daughters are kept in a list. As the views, the
+     index is valid as long as the collection is not modified or destroyed.
+*/
+//
+// Original Author:  agent
+//         Created:  Mon, 19 Oct 2026 00:04:50 GMT
+//
+//
+
+// system include files
+#include <vector>
+#include <limits>
+//
+// user include files
+#include "Analysis/Core/interface/GenParticle.h"
+#include "Analysis/Core/interface/CandidateView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class GenParticleIndex {
+         public:
+            /// particles of a |pdgId|, ordered by status
+            class Range {
+               public:
+                  class const_iterator {
+                     public:
+                        const_iterator(const GenParticle * data, std::vector<unsigned int>::const_iterator it) : data_(data), it_(it) {}
+                        const GenParticle & operator*()  const { return data_[*it_]; }
+                        const GenParticle * operator->() const { return &data_[*it_]; }
+                        const_iterator & operator++()          { ++it_; return *this; }
+                        bool operator==(const const_iterator & it) const { return it_ == it.it_; }
+                        bool operator!=(const const_iterator & it) const { return it_ != it.it_; }
+                     private:
+                        const GenParticle * data_;
+                        std::vector<unsigned int>::const_iterator it_;
+                  };
+
+                  Range(const GenParticleIndex * index, const size_t & first, const size_t & last);
+                  size_t size()  const;
+                  bool   empty() const;
+                  const GenParticle & operator[](const size_t & i) const;
+                  /// index in the collection of the i-th particle of the range
+                  unsigned int index(const size_t & i) const;
+                  const_iterator begin() const;
+                  const_iterator end()   const;
+                  /// the particles of the range with smin <= status <= smax
+                  Range status(const int & smin, const int & smax = std::numeric_limits<int>::max()) const;
+
+               private:
+                  const GenParticleIndex * index_;
+                  size_t first_;
+                  size_t last_;
+            };
+
+            GenParticleIndex();
+            GenParticleIndex(const ObjectView<GenParticle> & particles);
+           ~GenParticleIndex();
+
+            /// number of particles
+            size_t size() const;
+            /// the i-th particle of the collection
+            const GenParticle & particle(const unsigned int & i) const;
+            /// particles with |pdgId| == pdg (the sign is ignored)
+            Range  withPdg(const int & pdg) const;
+            /// the Higgs daughters, in the order of the collection
+            const std::vector<const GenParticle *> & higgsDaughters() const;
+
+         private:
+            const GenParticle * data_;
+            // indices of the particles sorted by (|pdgId|, status, index), and their keys
+            std::vector<unsigned int> order_;
+            std::vector<int> pdg_;
+            std::vector<int> status_;
+            std::vector<const GenParticle *> higgsDaughters_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline GenParticleIndex::Range::Range(const GenParticleIndex * index, const size_t & first, const size_t & last) :
+         index_(index), first_(first), last_(last) {}
+      inline size_t GenParticleIndex::Range::size()  const { return last_ - first_; }
+      inline bool   GenParticleIndex::Range::empty() const { return last_ == first_; }
+      inline const GenParticle & GenParticleIndex::Range::operator[](const size_t & i) const { return index_ -> data_[index_ -> order_[first_+i]]; }
+      inline unsigned int GenParticleIndex::Range::index(const size_t & i) const { return index_ -> order_[first_+i]; }
+      inline GenParticleIndex::Range::const_iterator GenParticleIndex::Range::begin() const { return const_iterator(index_ -> data_, index_ -> order_.begin() + first_); }
+      inline GenParticleIndex::Range::const_iterator GenParticleIndex::Range::end()   const { return const_iterator(index_ -> data_, index_ -> order_.begin() + last_); }
+
+      inline size_t GenParticleIndex::size() const { return order_.size(); }
+      inline const GenParticle & GenParticleIndex::particle(const unsigned int & i) const { return data_[i]; }
+      inline const std::vector<const GenParticle *> & GenParticleIndex::higgsDaughters() const { return higgsDaughters_; }
+
+   }
+}
+
+#endif  // Analysis_Core_GenParticleIndex_h
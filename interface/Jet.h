@@ -27,6 +27,8 @@
 // user include files
 #include "Analysis/Core/interface/Candidate.h"
 #include "Analysis/Core/interface/GenParticle.h"
+#include "Analysis/Core/interface/CandidateView.h"
+#include "Analysis/Core/interface/GenParticleIndex.h"
 //
 // class declaration
 //
@@ -66,7 +68,7 @@ namespace analysis {
             /// returns the extended flavour definition
             std::string extendedFlavour()       const;
             /// returns the vector of pointers to the generated partons
-            std::vector< std::shared_ptr<GenParticle> > partons() const;
+            std::vector<const GenParticle *> partons() const;
             /// returns jet energy resolution
             float JerResolution() const;
             /// returns jet energy resolution SF
@@ -75,6 +77,8 @@ namespace analysis {
             float JerSfDown() const;
             /// returns jet energy resolution SF Up variation
             float JerSfUp() const;
+            /// returns jet energy resolution SF shifted by n_sigma (>0 towards Up, <0 towards Down)
+            float JerSfVariation(const double & n_sigma) const;
             
             float neutralHadronFraction()  const ;
             float neutralEmFraction()      const ;
@@ -112,7 +116,7 @@ namespace analysis {
             /// sets jet energy resolution SF Down variation
             void JerSfDown(const float & jerSfDown);
             /// add parton that gave rise to jet
-            void addParton(const std::shared_ptr<GenParticle> &);
+            void addParton(const GenParticle *);
             /// remove parton from jet parton list
             int removeParton(const int &);
             
@@ -133,8 +137,10 @@ namespace analysis {
                     const float & cMult   ,
                     const float & muFrac  );
             
-            /// associate partons to the jet
-            void associatePartons(const std::vector< std::shared_ptr<GenParticle> > &, const float & dRmax = 0.5, const float & ptMin = 1., const bool & pythi8 = true );
+            /// associate partons to the jet; they point to the generated particles, which must outlive the jet
+            void associatePartons(const ObjectView<GenParticle> &, const float & dRmax = 0.5, const float & ptMin = 1., const bool & pythi8 = true );
+            /// as above, looking only at the partons of the status of the generator in the index
+            void associatePartons(const GenParticleIndex &, const float & dRmax = 0.5, const float & ptMin = 1., const bool & pythi8 = true );
 //            using Candidate::set; // in case needed to overload the function set
             
          protected:
@@ -153,7 +159,7 @@ namespace analysis {
             /// extended flavour identification for merged jets
             std::string extendedFlavour_;
             /// vector of pointers to Genparticles from merged jets
-            std::vector< std::shared_ptr<GenParticle> > partons_;
+            std::vector<const GenParticle *> partons_;
             /// jet id loose working point
             bool  idloose_;
             /// jet id tight working point
@@ -181,6 +187,8 @@ namespace analysis {
          private:
             // ----------member data ---------------------------
             
+            void addParton_(const GenParticle & particle, const float & dRmax, const float & ptMin, const bool & pythia8, const int & flavour, int & flavCounter);
+            void setExtendedFlavour_(const int & flavour, const int & flavCounter);
       };
    }
 }
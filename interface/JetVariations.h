@@ -0,0 +1,142 @@
+#ifndef Analysis_Core_JetVariations_h
+#define Analysis_Core_JetVariations_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      JetVariations
+//
+/**\class JetVariations JetVariations.cc Analysis/Core/src/JetVariations.cc
+
+ Description: Systematic variations (JER, JEC up/down) of the jets of an event, from the same jets
+
+ Implementation:
+     The jets are read once and not modified. A variation only keeps the
+     columns it changes, pt and energy, and its pt ordering; eta, phi, btag,
+     id and matching are those of the jets. The columns of a variation are
+     computed when it is first used, so the selections and histograms of all
+     variations run in the same event loop, e.g.
+        JetVariations vars(jets, analysis.randomStream("Jets"), "GenJets");
+        vars.addJerJec();
+        for ( size_t v = 0 ; v < vars.size() ; ++v ) ... vars.pt(v,i) ... vars.name(v)
+     The jets are given unsmeared. JER uses the random numbers of smearTo
+     with the same stream (draws 0 and 1 of each jet), the same for all
+     variations, so that the variations of a jet are correlated. Variation 0
+     is the nominal, smeared with the central JER scale factor; the JEC
+     variations are scaled from it.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:58:11 GMT
+//
+//
+
+// system include files
+#include <string>
+#include <vector>
+//
+// user include files
+#include "TLorentzVector.h"
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/CollectionView.h"
+#include "Analysis/Core/interface/RandomStream.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class JetVariations {
+         public:
+            enum Type { JER, JEC };
+
+            JetVariations();
+            /// variations of a view of jets; genJets is the collection the jets are matched to for JER
+            JetVariations(const CollectionView<Jet> & jets, const RandomStream & random, const std::string & genJets = "");
+           ~JetVariations();
+
+            /// adds a variation of n_sigma of a type, e.g. add("jerUp", JetVariations::JER, 1); returns its number
+            size_t add(const std::string & name, const Type & type, const double & n_sigma);
+            /// adds jerUp, jerDown, jecUp and jecDown
+            void   addJerJec();
+
+            /// number of variations, including the nominal (JER with n_sigma 0)
+            size_t size()  const;
+            /// number of jets
+            size_t nJets() const;
+            const std::string & name(const size_t & v) const;
+            Type   type(const size_t & v) const;
+            double nSigma(const size_t & v) const;
+            /// number of the variation of a name, -1 if none
+            int    find(const std::string & name) const;
+            /// the jets, unchanged
+            const CollectionView<Jet> & jets() const;
+
+            /// pt and energy of the i-th jet of the view in variation v
+            float pt(const size_t & v, const size_t & i) const;
+            float e(const size_t & v, const size_t & i)  const;
+            const std::vector<float> & pts(const size_t & v) const;
+            const std::vector<float> & es(const size_t & v)  const;
+            /// four momentum of the i-th jet in variation v
+            TLorentzVector p4(const size_t & v, const size_t & i) const;
+            /// invariant mass of the jets i and j in variation v, 0 if m^2 < 0 from rounding
+            float m(const size_t & v, const size_t & i, const size_t & j) const;
+            /// positions in the view of the jets in decreasing pt of variation v
+            const std::vector<unsigned int> & ptOrder(const size_t & v) const;
+            /// the view of the k leading jets in pt of variation v (all if k < 0)
+            CollectionView<Jet> leading(const size_t & v, const int & k = -1) const;
+            /// number of jets with pt >= ptmin in variation v
+            size_t countPtMin(const size_t & v, const float & ptmin) const;
+
+         private:
+            struct Variation {
+               std::string name;
+               Type type;
+               double nSigma;
+               mutable bool computed;
+               mutable std::vector<float> pt;
+               mutable std::vector<float> e;
+               mutable std::vector<unsigned int> order;
+            };
+
+            const Variation & variation_(const size_t & v) const;
+            void compute_(const Variation & var) const;
+
+            CollectionView<Jet> jets_;
+            RandomStream random_;
+            std::string genJets_;
+            std::vector<Variation> variations_;
+            // the normals of the jets for pt and energy, shared by the JER variations
+            mutable std::vector<double> gausPt_;
+            mutable std::vector<double> gausE_;
+            mutable bool gaus_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline size_t JetVariations::size()  const { return variations_.size(); }
+      inline size_t JetVariations::nJets() const { return jets_.size(); }
+      inline const std::string & JetVariations::name(const size_t & v) const { return variations_.at(v).name; }
+      inline JetVariations::Type JetVariations::type(const size_t & v) const { return variations_.at(v).type; }
+      inline double JetVariations::nSigma(const size_t & v) const { return variations_.at(v).nSigma; }
+      inline const CollectionView<Jet> & JetVariations::jets() const { return jets_; }
+
+      inline const JetVariations::Variation & JetVariations::variation_(const size_t & v) const
+      {
+         const Variation & var = variations_.at(v);
+         if ( ! var.computed ) this -> compute_(var);
+         return var;
+      }
+      inline float JetVariations::pt(const size_t & v, const size_t & i) const { return this -> variation_(v).pt[i]; }
+      inline float JetVariations::e(const size_t & v, const size_t & i)  const { return this -> variation_(v).e[i];  }
+      inline const std::vector<float> & JetVariations::pts(const size_t & v) const { return this -> variation_(v).pt; }
+      inline const std::vector<float> & JetVariations::es(const size_t & v)  const { return this -> variation_(v).e;  }
+      inline const std::vector<unsigned int> & JetVariations::ptOrder(const size_t & v) const { return this -> variation_(v).order; }
+
+   }
+}
+
+#endif  // Analysis_Core_JetVariations_h
@@ -21,25 +21,34 @@
 
 // system include files
 #include <memory>
-#include <boost/numeric/ublas/matrix.hpp>
-#include <boost/numeric/ublas/io.hpp>
+#include <cstddef>
 // 
 // user include files
 #include "Analysis/Core/interface/Candidate.h"
 //
 // class declaration
 //
-using namespace boost::numeric::ublas;
 
 namespace analysis {
    namespace tools {
 
+      /// 2x2 covariance matrix of the MET in x and y, indexed as m(i,j)
+      struct METSignificanceMatrix {
+         float xx, xy, yx, yy;
+         float operator()(const int & i, const int & j) const;
+         float determinant() const;
+         /// closed form; the zero matrix if singular
+         METSignificanceMatrix inverse() const;
+      };
+
       class MET : public Candidate {
          public:
             MET();
             MET(const float & px, const float & py, const float & pz);
            ~MET();
-            matrix<float> significanceMatrix();
+            const METSignificanceMatrix & significanceMatrix() const;
+            /// MET significance, (px,py) C^-1 (px,py)^T with the covariance C; 0 if C is singular
+            float significance() const;
             float * genP();
             
             void significanceMatrix(const float &, const float &,const float &,const float &);
@@ -52,10 +61,40 @@ namespace analysis {
             // ----------member data ---------------------------
             
             // 
-            matrix<float> sig_;
+            METSignificanceMatrix sig_;
             float gen_p_[3];
             
       };
+
+      /// significances of n METs from columns, e.g. of a tree, without building the objects
+      void metSignificance(const float * px, const float * py,
+                           const float * xx, const float * xy, const float * yx, const float * yy,
+                           const size_t & n, float * out);
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline float METSignificanceMatrix::operator()(const int & i, const int & j) const
+      {
+         return i == 0 ? ( j == 0 ? xx : xy ) : ( j == 0 ? yx : yy );
+      }
+      inline float METSignificanceMatrix::determinant() const { return xx*yy - xy*yx; }
+      inline METSignificanceMatrix METSignificanceMatrix::inverse() const
+      {
+         float det = this -> determinant();
+         if ( det == 0 ) return METSignificanceMatrix{0,0,0,0};
+         return METSignificanceMatrix{yy/det, -xy/det, -yx/det, xx/det};
+      }
+
+      inline const METSignificanceMatrix & MET::significanceMatrix() const { return sig_; }
+      inline float MET::significance() const
+      {
+         float px = this -> px();
+         float py = this -> py();
+         float s;
+         metSignificance(&px, &py, &sig_.xx, &sig_.xy, &sig_.yx, &sig_.yy, 1, &s);
+         return s;
+      }
    }
 }
 
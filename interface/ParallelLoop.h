@@ -0,0 +1,92 @@
+#ifndef Analysis_Core_ParallelLoop_h
+#define Analysis_Core_ParallelLoop_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      ParallelLoop
+//
+/**\class ParallelLoop ParallelLoop.cc Analysis/Core/src/ParallelLoop.cc
+
+ Description: Event loop over several threads with work stealing
+
+ Implementation:
+     The events of the range of an Analysis (all of them, or its range or
+     shard) are handed out in cluster-sized chunks by a ChunkScheduler.
+     Each worker thread has only a FileManager of its own, a copy of that
+     of the Analysis that does not open the files again to count them, and
+     reads the trees it needs from its current file. For every event the
+     user function is called with the FileManager of the worker, whose
+     current file holds the event, and the entry in that file; when
+     newFile() is true the trees must be taken again with tree(path). The
+     user function must only touch objects of its own worker, e.g.
+     histograms booked per worker and added up after run().
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:15:30 GMT
+//
+//
+
+// system include files
+#include <memory>
+#include <vector>
+#include <functional>
+//
+// user include files
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "Analysis/Core/interface/FileManager.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class ParallelLoop {
+         public:
+            /// constructor from the Analysis defining the files and the range of events, and the number of worker threads
+            ParallelLoop(Analysis & analysis, const int & workers);
+           ~ParallelLoop();
+
+            /// returns the number of workers
+            int  workers();
+            /// runs the event loop calling process(files, entry, worker) for each event in the worker threads,
+            /// entry being that of the event in the current file of files
+            void run(const std::function<void(FileManager &, const Long64_t &, const int &)> & process);
+            /// returns the number of events processed by a worker in the last run
+            int  processed(const int & worker);
+            /// returns the number of chunks processed by a worker in the last run
+            int  chunks(const int & worker);
+            /// returns the number of chunks stolen by a worker in the last run
+            int  stolen(const int & worker);
+            /// prints the number of chunks and events processed and stolen by each worker
+            void listWorkers();
+
+            // ----------member data ---------------------------
+         protected:
+            std::vector< std::unique_ptr<FileManager> > files_;
+            Long64_t first_;
+            Long64_t last_;
+            std::vector<int> processed_;
+            std::vector<int> chunks_;
+            std::vector<int> stolen_;
+
+         private:
+
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      inline int ParallelLoop::workers()                       { return (int) files_.size(); }
+      inline int ParallelLoop::processed(const int & worker)   { return processed_.at(worker); }
+      inline int ParallelLoop::chunks(const int & worker)      { return chunks_.at(worker); }
+      inline int ParallelLoop::stolen(const int & worker)      { return stolen_.at(worker); }
+
+   }
+}
+
+#endif  // Analysis_Core_ParallelLoop_h
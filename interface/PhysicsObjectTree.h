@@ -41,7 +41,7 @@ namespace analysis {
       class PhysicsObjectTree : public PhysicsObjectTreeBase<Object> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<Object> collection();
@@ -58,7 +58,7 @@ namespace analysis {
       class PhysicsObjectTree<Jet> : public PhysicsObjectTreeBase<Jet> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<Jet> collection();
@@ -99,7 +99,7 @@ namespace analysis {
       class PhysicsObjectTree<Candidate> : public PhysicsObjectTreeBase<Candidate> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<Candidate> collection();
@@ -116,7 +116,7 @@ namespace analysis {
       class PhysicsObjectTree<GenParticle> : public PhysicsObjectTreeBase<GenParticle> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<GenParticle> collection();
@@ -137,10 +137,12 @@ namespace analysis {
       class PhysicsObjectTree<MET> : public PhysicsObjectTreeBase<MET>{
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<MET> collection();
+            /// significances of the METs of the event, from the columns
+            std::vector<float> significances() const;
             // ----------member data ---------------------------
          protected:
             // METs
@@ -162,7 +164,7 @@ namespace analysis {
       class PhysicsObjectTree<Muon> : public PhysicsObjectTreeBase<Muon> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<Muon> collection();
@@ -179,7 +181,7 @@ namespace analysis {
       class PhysicsObjectTree<JetTag> : public PhysicsObjectTreeBase<JetTag> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<JetTag> collection();
@@ -196,7 +198,7 @@ namespace analysis {
       class PhysicsObjectTree<GenJet> : public PhysicsObjectTreeBase<GenJet> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<GenJet> collection();
@@ -213,10 +215,12 @@ namespace analysis {
       class PhysicsObjectTree<Vertex> : public PhysicsObjectTreeBase<Vertex> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<Vertex> collection();
+            /// nGoodPV, PV z and densities from the columns of the event, in one pass
+            VertexSummary summary() const;
 
             // ----------member data ---------------------------
          protected:
@@ -230,7 +234,7 @@ namespace analysis {
       class PhysicsObjectTree<TriggerObject> : public PhysicsObjectTreeBase<TriggerObject> {
          public:
             PhysicsObjectTree();
-            PhysicsObjectTree(TChain * tree, const std::string & name);
+            PhysicsObjectTree(TTree * tree, const std::string & name);
            ~PhysicsObjectTree();
 
             Collection<TriggerObject> collection();
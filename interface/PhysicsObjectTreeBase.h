@@ -49,11 +49,17 @@ namespace analysis {
       class PhysicsObjectTreeBase : public TreeBase {
          public:
             PhysicsObjectTreeBase();
-            PhysicsObjectTreeBase(TChain * tree, const std::string & name);
+            PhysicsObjectTreeBase(TTree * tree, const std::string & name);
            ~PhysicsObjectTreeBase();
 
+            /// gives back the objects of a collection no longer used, their storage is reused by the next collection
+            void recycle(std::vector<Object> && objects);
+
             // ----------member data ---------------------------
          protected:
+            std::vector<Object> storage_();
+            std::vector<Object> recycled_;
+
             static const int max_ = 1000;
             // general candidates (e.g. physics objects)
             int n_;
@@ -75,11 +81,17 @@ namespace analysis {
       class PhysicsObjectTreeBase<Vertex> : public TreeBase {
          public:
             PhysicsObjectTreeBase();
-            PhysicsObjectTreeBase(TChain * tree, const std::string & name);
+            PhysicsObjectTreeBase(TTree * tree, const std::string & name);
            ~PhysicsObjectTreeBase();
 
+            /// gives back the objects of a collection no longer used, their storage is reused by the next collection
+            void recycle(std::vector<Vertex> && objects);
+
             // ----------member data ---------------------------
          protected:
+            std::vector<Vertex> storage_();
+            std::vector<Vertex> recycled_;
+
             static const int max_ = 400;
 
             // general candidates
@@ -98,6 +110,32 @@ namespace analysis {
          private:
 
       };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <typename Object>
+      inline void PhysicsObjectTreeBase<Object>::recycle(std::vector<Object> && objects) { recycled_ = std::move(objects); }
+      template <typename Object>
+      inline std::vector<Object> PhysicsObjectTreeBase<Object>::storage_()
+      {
+         // empty, with the capacity of the recycled objects
+         std::vector<Object> objects(std::move(recycled_));
+         recycled_.clear();
+         objects.clear();
+         objects.reserve(n_);
+         return objects;
+      }
+
+      inline void PhysicsObjectTreeBase<Vertex>::recycle(std::vector<Vertex> && objects) { recycled_ = std::move(objects); }
+      inline std::vector<Vertex> PhysicsObjectTreeBase<Vertex>::storage_()
+      {
+         std::vector<Vertex> objects(std::move(recycled_));
+         recycled_.clear();
+         objects.clear();
+         objects.reserve(n_);
+         return objects;
+      }
    }
 }
 
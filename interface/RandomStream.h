@@ -0,0 +1,76 @@
+#ifndef Analysis_Core_RandomStream_h
+#define Analysis_Core_RandomStream_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      RandomStream
+//
+/**\class RandomStream RandomStream.cc Analysis/Core/src/RandomStream.cc
+
+ Description: Reproducible random numbers per event, collection, object and variation
+
+ Implementation:
+     Counter-based generator (Philox4x32-10, Salmon et al., SC11): the random
+     numbers are a function of (run, lumi) as key and (event, collection,
+     object index, variation, draw) as counter, with no state. The same
+     object of the same event therefore gets the same numbers whatever the
+     order the events are processed in, the thread or the shard, and streams
+     can be used concurrently.
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:53:27 GMT
+//
+//
+
+// system include files
+#include <stdint.h>
+#include <string>
+#include <vector>
+//
+// user include files
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class RandomStream {
+         public:
+            RandomStream();
+            /// stream of a collection in an event; variation distinguishes e.g. systematic variations
+            RandomStream(const int & run, const int & lumi, const int & event, const std::string & collection, const int & variation = 0);
+           ~RandomStream();
+
+            /// four random 32-bit words of an object; block numbers the groups of four
+            void   words(const unsigned int & index, const unsigned int & block, uint32_t out[4]) const;
+            /// uniform in (0,1), the draw-th one of an object
+            double uniform(const unsigned int & index, const unsigned int & draw = 0) const;
+            /// standard normal, the draw-th one of an object
+            double gaus(const unsigned int & index, const unsigned int & draw = 0) const;
+            double gaus(const unsigned int & index, const double & mean, const double & sigma, const unsigned int & draw = 0) const;
+            /// the standard normals of draws 0 and 1 of the objects 0..n-1, e.g. for a whole collection at once
+            void   gaus(const size_t & n, std::vector<double> & draw0, std::vector<double> & draw1) const;
+
+            /// 32-bit hash of a name (FNV-1a)
+            static uint32_t hash(const std::string & name);
+            /// the Philox4x32-10 bijection, replacing the counter by the random words of the key
+            static void philox(uint32_t ctr[4], const uint32_t key[2]);
+
+         private:
+            static double uniform_(const uint32_t & high, const uint32_t & low);
+            void counter_(const unsigned int & index, const unsigned int & block, uint32_t ctr[4]) const;
+
+            uint32_t key_[2];
+            uint32_t event_;
+            uint32_t collection_;
+            uint32_t variation_;
+      };
+
+   }
+}
+
+#endif  // Analysis_Core_RandomStream_h
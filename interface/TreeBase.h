@@ -43,19 +43,37 @@ namespace analysis {
       class TreeBase : public TChain{
          public:
             TreeBase();
-            TreeBase(TChain * tree, const std::string & name);
+            TreeBase(TTree * tree, const std::string & name);
            ~TreeBase();
            
            void event(const int & event);
-           TChain * tree();
+           /// returns the bytes decompressed by the events read so far
+           Long64_t bytes();
+           /// returns the compressed bytes of the baskets read so far for the events
+           Long64_t zipBytes();
+           TTree * tree();
+           /// replaces the tree, e.g. when the file changes, and sets again the branch addresses
+           void tree(TTree * tree);
+           /// sets the address of a branch and keeps it for when the tree is replaced
+           void branch(const std::string & name, void * address);
+           std::vector<std::string> branches();
+           /// returns the branches whose addresses were set, i.e. the ones to be read
+           std::vector<std::string> branchesRead();
            
             // ----------member data ---------------------------
          protected:
-            TChain * tree_;
+            TTree * tree_;
             std::string className_;
             std::string inputTag_;
             
             std::vector<std::string> branches_;
+            std::vector< std::pair<std::string, void *> > addresses_;
+            
+            Long64_t bytes_;
+            Long64_t zipBytes_;
+            // branches of the tree and the last basket of each one counted in zipBytes_
+            void initBaskets_(TObjArray * branches);
+            std::vector< std::pair<TBranch *, Int_t> > baskets_;
             
             std::string name_;
             
@@ -0,0 +1,120 @@
+#ifndef Analysis_Core_TruthMatcher_h
+#define Analysis_Core_TruthMatcher_h 1
+
+// -*- C++ -*-
+//
+// Package:    Analysis/Core
+// Class:      TruthMatcher
+//
+/**\class TruthMatcher TruthMatcher.cc Analysis/Core/src/TruthMatcher.cc
+
+ Description: Chained, unique deltaR (and deltaPt) matching, e.g. GenParticle -> GenJet -> Jet
+
+ Implementation:
+     The objects are given in levels, the first being the sources, e.g. the
+     Higgs b quarks, then e.g. the generated jets and the reconstructed jets.
+     The matched objects of a level are matched to those of the next one:
+     the objects of the next level are put in an eta-phi grid of cells of
+     size dRmax, so that only the 3x3 neighbouring cells are looked at, the
+     pairs within dRmax (and the relative pt difference, if given) are
+     sorted by deltaR and taken greedily, the closest first, with each
+     object used once. The result is a table with a row per source and the
+     index of the matched object in each level, -1 where the chain breaks.
+     Only pointers to the objects are kept, they must outlive the matcher.
+*/
+//
+// Original Author:  agent
+//         Created:  Mon, 19 Oct 2026 00:07:01 GMT
+//
+//
+
+// system include files
+#include <vector>
+//
+// user include files
+#include "Analysis/Core/interface/Utils.h"
+#include "Analysis/Core/interface/Candidate.h"
+#include "Analysis/Core/interface/CandidateView.h"
+
+//
+// class declaration
+//
+
+namespace analysis {
+   namespace tools {
+
+      class TruthMatcher {
+         public:
+            TruthMatcher();
+           ~TruthMatcher();
+
+            /// adds the next level of objects; dRmax and dPtRelMax (not used if <= 0) are the cuts
+            /// to the matched objects of the previous level, not used for the first level
+            void add(const CandidateView & objects, const float & dRmax = 0.4, const float & dPtRelMax = -1);
+            template <class Object>
+            void add(const std::vector<const Object *> & objects, const float & dRmax = 0.4, const float & dPtRelMax = -1);
+            /// runs the matching of all levels; the table is then filled
+            void match();
+            /// removes the levels and the table, e.g. for the next event
+            void clear();
+
+            /// number of sources, the rows of the table
+            size_t size()   const;
+            /// number of levels, the columns of the table
+            size_t levels() const;
+            /// index of the object of a level matched to a source, -1 if none
+            int    index(const size_t & source, const size_t & level) const;
+            /// the object of a level matched to a source, nullptr if none
+            const Candidate * object(const size_t & source, const size_t & level) const;
+            /// deltaR between the objects matched to a source in a level and the previous one, -1 if none
+            float  deltaR(const size_t & source, const size_t & level) const;
+            /// if the source is matched in all levels
+            bool   complete(const size_t & source) const;
+            /// the table, row major
+            const std::vector<int> & table() const;
+
+         private:
+            struct Level {
+               std::vector<const Candidate *> objects;
+               std::vector<float> eta;
+               std::vector<float> phi;
+               std::vector<float> pt;
+               float dRmax;
+               float dPtRelMax;
+               // of the objects matched to the previous level, -1 if none
+               std::vector<int>   previous;
+               std::vector<float> deltaR;
+            };
+
+            void addLevel_(std::vector<const Candidate *> && objects, const float & dRmax, const float & dPtRelMax);
+            void matchLevel_(const Level & from, const std::vector<bool> & active, Level & to);
+
+            std::vector<Level> levels_;
+            std::vector<int>   table_;
+            std::vector<float> deltaR_;
+      };
+
+      // ===============================================
+      // INLINE IMPLEMENTATIONS
+
+      template <class Object>
+      void TruthMatcher::add(const std::vector<const Object *> & objects, const float & dRmax, const float & dPtRelMax)
+      {
+         this -> addLevel_(std::vector<const Candidate *>(objects.begin(), objects.end()), dRmax, dPtRelMax);
+      }
+
+      inline size_t TruthMatcher::size()   const { return levels_.empty() ? 0 : levels_[0].objects.size(); }
+      inline size_t TruthMatcher::levels() const { return levels_.size(); }
+      inline int    TruthMatcher::index(const size_t & source, const size_t & level) const { return table_[source*levels_.size() + level]; }
+      inline float  TruthMatcher::deltaR(const size_t & source, const size_t & level) const { return deltaR_[source*levels_.size() + level]; }
+      inline const Candidate * TruthMatcher::object(const size_t & source, const size_t & level) const
+      {
+         int i = this -> index(source, level);
+         return i < 0 ? nullptr : levels_[level].objects[i];
+      }
+      inline const std::vector<int> & TruthMatcher::table() const { return table_; }
+
+   }
+}
+
+#endif  // Analysis_Core_TruthMatcher_h
@@ -1,6 +1,11 @@
 #ifndef Analysis_Core_Utils_h
 #define Analysis_Core_Utils_h 1
 
+#include <map>
+#include <string>
+#include <utility>
+#include <cmath>
+
 namespace analysis {
    namespace tools {
 
@@ -16,6 +21,81 @@ namespace analysis {
          std::pair<int,int> id;
          std::pair<double,double> x;
       };
+      
+      /// event information and trigger results as read from the trees
+      struct EventData
+      {
+         int    event;
+         int    run;
+         int    lumi;
+         int    nPileup;
+         float  nTruePileup;
+         float  lumiPileup;
+         float  instantLumi;
+         double genWeight;
+         double genScale;
+         PDF    pdf;
+         std::map<std::string, bool> triggerResults;
+         std::map<std::string, int>  triggerResultsPS;
+      };
+      
+      /// counters of the event loop
+      struct MonitorInfo
+      {
+         long   events;              // events read
+         long   preselected;         // events passing the preselections
+         double seconds;             // wall time since the first event
+         double eventRate;           // events per second
+         double eta;                 // seconds until the end of the event range
+         double readSeconds;         // time reading the trees (GetEntry)
+         double collectionSeconds;   // time building the collections
+         double userSeconds;         // time in the user code between events
+         double fileOpenSeconds;     // time opening files
+         int    filesOpened;
+         long long bytesRead;        // bytes read from the files
+         std::map<std::string, long long> treeBytes;      // decompressed bytes per tree
+         std::map<std::string, long long> treeZipBytes;   // compressed bytes per tree, of the baskets read
+      };
+      
+      /// typed index of a tree and its collection in an Analysis, e.g. as returned by addTree<Object>
+      template <class Object>
+      struct CollectionHandle
+      {
+         CollectionHandle() : index(-1) {}
+         CollectionHandle(const int & i, const std::string & n) : index(i), name(n) {}
+         bool valid() const { return index >= 0; }
+         int         index;   // slot in the registry of the Analysis, -1 if invalid
+         std::string name;
+      };
+      
+      /// typed index of a per-event summary of a tree in an Analysis, e.g. as returned by addVertexSummary;
+      /// a summary is not a collection, so collection() and tree() do not take it
+      template <class Summary>
+      struct SummaryHandle
+      {
+         SummaryHandle() : index(-1) {}
+         SummaryHandle(const int & i, const std::string & n) : index(i), name(n) {}
+         bool valid() const { return index >= 0; }
+         int         index;   // slot in the registry of the Analysis, -1 if invalid
+         std::string name;
+      };
+      
+      /// phi1 - phi2 folded into [-pi,pi), for any phi; no branches, so loops over it vectorize
+      inline float deltaPhi(const float & phi1, const float & phi2)
+      {
+         const float pi    = M_PI;
+         const float twopi = 2*M_PI;
+         float dphi = phi1 - phi2;
+         return dphi - twopi * std::floor((dphi + pi) / twopi);
+      }
+      
+      /// deltaR^2, the kernel of all deltaR computations of the column based tools
+      inline float deltaR2(const float & eta1, const float & phi1, const float & eta2, const float & phi2)
+      {
+         float deta = eta1 - eta2;
+         float dphi = deltaPhi(phi1, phi2);
+         return deta*deta + dphi*dphi;
+      }
    }
 }
 
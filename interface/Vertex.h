@@ -110,6 +110,24 @@ namespace analysis {
 
          private:
       };
+
+      /// per-event quantities of the primary vertices, computed from the vertex columns without building Vertex objects
+      struct VertexSummary {
+         VertexSummary();
+         /// number of vertices
+         int   n;
+         /// number of good vertices: not fake, ndof > 4, |z| <= 24 cm, rho <= 2 cm
+         int   nGood;
+         /// z of the primary vertex, the first one (-999 if no vertex)
+         float pvZ;
+         /// if the primary vertex is good
+         bool  pvGood;
+         /// mean and rms of z of the good vertices (0 if none)
+         float zMean;
+         float zRms;
+         /// other good vertices per cm along z within 1 cm of the primary vertex, the local pileup density
+         float pvDensity;
+      };
    }
 }
 
@@ -15,9 +15,14 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cstdio>
+#include <iomanip>
 //
 // user include files
 #include "TKey.h"
+#include "TROOT.h"
+#include "TParameter.h"
+#include "TVectorD.h"
 #include "Analysis/Core/interface/Analysis.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -38,42 +43,76 @@ Analysis::Analysis(const std::string & inputFilelist, const std::string & evtinf
    inputFilelist_  = inputFilelist;
    fileCollection_ = new TFileCollection("fileCollection","",inputFilelist.c_str());
    fileList_ = (TCollection*) fileCollection_->GetList();
+   
+   // all trees are read from a single open file per input
+   files_ = new FileManager(fileList_,evtinfo);
+   
+   t_triggerResults_ = nullptr;
+   
+   pipeline_  = false;
+   entry_     = 0;
+   requested_ = -1;
+   decoded_   = -1;
+   requestedCollections_ = false;
+   decodedCollections_   = false;
+   stop_      = false;
+   rereadWarned_ = false;
+   
+   monitorSeconds_    = 0;
+   nread_             = 0;
+   readSeconds_       = 0;
+   collectionSeconds_ = 0;
+   userSeconds_       = 0;
+   monitorStarted_    = false;
+   
+   stagedReading_     = false;
+   stagedEntry_       = -1;
+   npreselected_      = 0;
+   
+   checkpointFile_    = "";
+   checkpointEvents_  = 0;
+   checkpointSeconds_ = 0;
+   checkpointLast_    = 0;
+   checkpointElapsed_ = 0;
+   checkpointStride_  = 1000;
 
    // event info (must be in the tree always)
-   t_event_ = new TChain(evtinfo.c_str());
-   t_event_ -> AddFileInfoList(fileList_);
+   eventInfoPath_ = evtinfo;
+   t_event_ = new TreeBase(files_ -> tree(evtinfo), "EventInfo");
    
-   std::vector<std::string> branches;
-   TObjArray * treeBranches = t_event_->GetListOfBranches();
-   for ( int i = 0 ; i < treeBranches->GetEntries() ; ++i )
-      branches.push_back(treeBranches->At(i)->GetName());
+   std::vector<std::string> branches = t_event_ -> branches();
    
-   t_event_ -> SetBranchAddress("event", &event_);
-   t_event_ -> SetBranchAddress("run", &run_);
-   t_event_ -> SetBranchAddress("lumisection", &lumi_);
+   t_event_ -> branch("event", &event_);
+   t_event_ -> branch("run", &run_);
+   t_event_ -> branch("lumisection", &lumi_);
    
    // For backward compatibility
    std::vector<std::string>::iterator it;
-   it = std::find(branches.begin(),branches.end(),"nPileup");      if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &n_pu_);
-   it = std::find(branches.begin(),branches.end(),"nTruePileup");  if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &n_true_pu_);
+   it = std::find(branches.begin(),branches.end(),"nPileup");      if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &n_pu_);
+   it = std::find(branches.begin(),branches.end(),"nTruePileup");  if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &n_true_pu_);
    
-   it = std::find(branches.begin(),branches.end(),"lumiPileup");   if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &lumi_pu_);
-   it = std::find(branches.begin(),branches.end(),"instantLumi");  if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &inst_lumi_);
+   it = std::find(branches.begin(),branches.end(),"lumiPileup");   if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &lumi_pu_);
+   it = std::find(branches.begin(),branches.end(),"instantLumi");  if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &inst_lumi_);
    
-   it = std::find(branches.begin(),branches.end(),"genWeight");    if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &genWeight_);
-   it = std::find(branches.begin(),branches.end(),"genScale");     if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &genScale_);
-   it = std::find(branches.begin(),branches.end(),"pdfid1");       if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &pdf_.id.first);
-   it = std::find(branches.begin(),branches.end(),"pdfid2");       if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &pdf_.id.second);
-   it = std::find(branches.begin(),branches.end(),"pdfx1");        if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &pdf_.x.first);
-   it = std::find(branches.begin(),branches.end(),"pdfx2");        if ( it != branches.end() ) t_event_  -> SetBranchAddress( (*it).c_str(), &pdf_.x.second);
+   it = std::find(branches.begin(),branches.end(),"genWeight");    if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &genWeight_);
+   it = std::find(branches.begin(),branches.end(),"genScale");     if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &genScale_);
+   it = std::find(branches.begin(),branches.end(),"pdfid1");       if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &pdf_.id.first);
+   it = std::find(branches.begin(),branches.end(),"pdfid2");       if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &pdf_.id.second);
+   it = std::find(branches.begin(),branches.end(),"pdfx1");        if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &pdf_.x.first);
+   it = std::find(branches.begin(),branches.end(),"pdfx2");        if ( it != branches.end() ) t_event_  -> branch( (*it).c_str(), &pdf_.x.second);
    
    
 //   t_event_ -> SetBranchAddress("nPileup", &n_pu_);
 //   t_event_ -> SetBranchAddress("nTruePileup", &n_true_pu_);
 
-   nevents_ = t_event_ -> GetEntries();
+   nevents_ = files_ -> entries();
+   first_   = 0;
+   last_    = nevents_;
+   rangeFirst_ = 0;
 
-   t_event_ -> GetEntry(1); // Check whether it's mc simulation
+   Long64_t entry = files_ -> entry(1);
+   if ( files_ -> newFile() ) this -> treesReload_();
+   t_event_ -> event(entry); // Check whether it's mc simulation
    if (run_ == 1) {         // A bit stupid, but it's only solution that I found for the moment
      is_mc_ = true;
    } else {
@@ -84,7 +123,6 @@ Analysis::Analysis(const std::string & inputFilelist, const std::string & evtinf
    btageff_flavour_ = "";
    
    mylumi_= -1.;
-
    
    //if(is_mc_) crossSection();
 
@@ -94,6 +132,9 @@ Analysis::~Analysis()
 {
    // do anything here that needs to be done at desctruction time
    // (e.g. close files, deallocate resources etc.)
+   this -> pipeline(false);
+   if ( files_ -> cache() ) files_ -> cacheReport();
+   delete files_;
 }
 
 
@@ -101,8 +142,33 @@ Analysis::~Analysis()
 // member functions
 //
 // ------------ method called for each event  ------------
-void Analysis::event(const int & event, const bool & addCollections)
+bool Analysis::event(const int & event, const bool & addCollections)
 {
+   // time of the user code since the previous event
+   auto eventStart = std::chrono::steady_clock::now();
+   if ( monitorStarted_ )
+   {
+      userSeconds_ += std::chrono::duration<double>(eventStart - eventEnd_).count();
+   }
+   else
+   {
+      monitorStart_   = eventStart;
+      monitorReport_  = eventStart;
+      monitorStarted_ = true;
+   }
+   ++nread_;
+   
+   // the previous events are done
+   if ( checkpointFile_ != "" )
+   {
+      int since = first_ + event - checkpointLast_;
+      bool due = checkpointEvents_ > 0 && since >= checkpointEvents_;
+      // the clock only every checkpointStride_ events
+      if ( ! due && checkpointSeconds_ > 0 && since > 0 && since % checkpointStride_ == 0 )
+         due = std::chrono::steady_clock::now() - checkpointTime_ >= std::chrono::seconds(checkpointSeconds_);
+      if ( due ) this -> checkpointWrite_(first_ + event);
+   }
+   
    // Initialisation for backward compatibility
    n_pu_ = -1;
    n_true_pu_ = -1;
@@ -114,24 +180,629 @@ void Analysis::event(const int & event, const bool & addCollections)
    pdf_.x.first  = -1.;
    pdf_.x.second = -1.;
    
-   t_event_ -> GetEntry(event);
-   if ( !addCollections) return;
+   // events are counted from the beginning of the range
+   int evt = first_ + event;
+   
+   if ( pipeline_ )
+   {
+      // the event was most likely decoded in the background already
+      this -> readerWait_();
+      if ( decoded_ != evt || ( addCollections && ! decodedCollections_ ) )
+         this -> decode_(evt, addCollections);
+      
+      event_     = buffer_.event;
+      run_       = buffer_.run;
+      lumi_      = buffer_.lumi;
+      n_pu_      = buffer_.nPileup;
+      n_true_pu_ = buffer_.nTruePileup;
+      lumi_pu_   = buffer_.lumiPileup;
+      inst_lumi_ = buffer_.instantLumi;
+      genWeight_ = buffer_.genWeight;
+      genScale_  = buffer_.genScale;
+      pdf_       = buffer_.pdf;
+      for ( auto & tr : buffer_.triggerResults )   triggerResults_[tr.first]   = tr.second;
+      for ( auto & ps : buffer_.triggerResultsPS ) triggerResultsPS_[ps.first] = ps.second;
+      if ( addCollections )
+         for ( auto & slot : slots_ )
+            if ( slot.next ) slot.collection = std::move(slot.next);
+      entry_ = evt;
+      bool selected = this -> preselect_();
+      
+      this -> monitor_();
+      
+      // meanwhile the next one
+      if ( evt+1 < last_ ) this -> readerRequest_(evt+1, addCollections);
+      eventEnd_ = std::chrono::steady_clock::now();
+      return selected;
+   }
+   
+   // the trees of the other inputs belong to the previous file
+   Long64_t entry = files_ -> entry(evt);
+   if ( files_ -> newFile() ) this -> treesReload_();
+   entry_ = evt;
+   
+   // first the event information and trigger results for the preselections
+   t_event_ -> event(entry);
+   if ( t_triggerResults_ ) t_triggerResults_ -> event(entry);
+   auto stageEnd = std::chrono::steady_clock::now();
+   readSeconds_ += std::chrono::duration<double>(stageEnd - eventStart).count();
+   bool selected = this -> preselect_();
+   
+   // the object trees are read when accessed, if at all
+   if ( stagedReading_ || ! selected )
+   {
+      stagedEntry_ = entry;
+      for ( auto & slot : slots_ )
+      {
+         slot.staged = (bool) slot.tree;
+         slot.stageCollection = addCollections;
+      }
+      eventEnd_ = std::chrono::steady_clock::now();
+      this -> monitor_();
+      return selected;
+   }
+   this -> unstage_();
+   
+   auto readStart = std::chrono::steady_clock::now();
+   for ( auto & slot : slots_ )
+      if ( slot.tree && slot.source < 0 ) slot.tree -> event(entry);
+   auto readEnd = std::chrono::steady_clock::now();
+   readSeconds_ += std::chrono::duration<double>(readEnd - readStart).count();
+   
+   if ( addCollections )
+   {
+      this -> collections_(false);
+      eventEnd_ = std::chrono::steady_clock::now();
+      collectionSeconds_ += std::chrono::duration<double>(eventEnd_ - readEnd).count();
+   }
+   else
+   {
+      eventEnd_ = readEnd;
+   }
+   
+   this -> monitor_();
+   
+   return selected;
+}
+
+// ------------ staged reading  ------------
+void Analysis::stagedReading(const bool & on)
+{
+   if ( on && pipeline_ )
+   {
+      std::cout << "Staged reading replaces the pipelined reading" << std::endl;
+      this -> pipeline(false);
+   }
+   stagedReading_ = on;
+   this -> unstage_();
+}
+
+void Analysis::addPreselection(const std::function<bool(Analysis &)> & selection)
+{
+   preselections_.push_back(selection);
+}
+
+bool Analysis::preselect_()
+{
+   for ( auto & selection : preselections_ )
+      if ( ! selection(*this) ) return false;
+   ++npreselected_;
+   return true;
+}
+
+void Analysis::stage_(const int & index)
+{
+   Slot & slot = slots_[index];
+   if ( ! slot.staged ) return;
+   slot.staged = false;
+   // a tree of another slot is read by that slot
+   if ( slot.source >= 0 ) this -> stage_(slot.source);
+   
+   auto start = std::chrono::steady_clock::now();
+   if ( slot.source < 0 ) slot.tree -> event(stagedEntry_);
+   auto readEnd = std::chrono::steady_clock::now();
+   if ( slot.stageCollection )
+      slot.collection = (this ->* slot.build)(slot);
+   auto end = std::chrono::steady_clock::now();
+   readSeconds_       += std::chrono::duration<double>(readEnd - start).count();
+   collectionSeconds_ += std::chrono::duration<double>(end - readEnd).count();
+   // not counted as user time
+   eventEnd_ += end - start;
+}
+
+// ------------ monitoring  ------------
+void Analysis::monitor(const int & seconds)
+{
+   monitorSeconds_ = seconds;
+}
+
+MonitorInfo Analysis::monitorInfo()
+{
+   // the reader thread must not be updating the counters
+   this -> readerWait_();
+   
+   MonitorInfo info;
+   info.events            = nread_;
+   info.preselected       = npreselected_;
+   info.seconds           = monitorStarted_ ? std::chrono::duration<double>(std::chrono::steady_clock::now() - monitorStart_).count() : 0;
+   info.eventRate         = info.seconds > 0 ? nread_/info.seconds : 0;
+   info.eta               = info.eventRate > 0 ? std::max(last_ - entry_ - 1, 0)/info.eventRate : 0;
+   info.readSeconds       = readSeconds_;
+   info.collectionSeconds = collectionSeconds_;
+   info.userSeconds       = userSeconds_;
+   info.fileOpenSeconds   = files_ -> fileOpenSeconds();
+   info.filesOpened       = files_ -> filesOpened();
+   info.bytesRead         = files_ -> bytesRead();
+   
+   info.treeBytes["EventInfo"]    = t_event_ -> bytes();
+   info.treeZipBytes["EventInfo"] = t_event_ -> zipBytes();
+   if ( t_triggerResults_ )
+   {
+      info.treeBytes["TriggerResults"]    = t_triggerResults_ -> bytes();
+      info.treeZipBytes["TriggerResults"] = t_triggerResults_ -> zipBytes();
+   }
+   for ( auto & slot : slots_ )
+   {
+      if ( ! slot.tree || slot.source >= 0 ) continue;
+      info.treeBytes[slot.name]    = slot.tree -> bytes();
+      info.treeZipBytes[slot.name] = slot.tree -> zipBytes();
+   }
+   return info;
+}
+
+void Analysis::monitor_()
+{
+   if ( monitorSeconds_ <= 0 ) return;
+   auto now = std::chrono::steady_clock::now();
+   if ( now - monitorReport_ < std::chrono::seconds(monitorSeconds_) ) return;
+   monitorReport_ = now;
+   
+   double seconds = std::chrono::duration<double>(now - monitorStart_).count();
+   double rate = seconds > 0 ? nread_/seconds : 0;
+   int    eta  = rate > 0 ? int(std::max(last_ - entry_ - 1, 0)/rate) : 0;
+   std::cout << "Event " << entry_ - rangeFirst_ + 1 << " of " << this -> rangeSize() << ": "
+             << int(rate) << " events/s, "
+             << files_ -> bytesRead()/seconds/1024/1024 << " MB/s read, "
+             << "ETA " << eta/3600 << "h" << std::setfill('0') << std::setw(2) << (eta/60)%60 << "m" << std::setw(2) << eta%60 << "s"
+             << std::setfill(' ') << std::endl;
+}
+
+void Analysis::listMonitor()
+{
+   MonitorInfo info = this -> monitorInfo();
+   std::cout << "=======================================================" << std::endl;
+   std::cout << "  EVENT LOOP" << std::endl;
+   std::cout << "=======================================================" << std::endl;
+   std::cout << "Events read          = " << info.events << " in " << info.seconds << " s (" << info.eventRate << " events/s)" << std::endl;
+   if ( ! preselections_.empty() )
+      std::cout << "Events preselected   = " << info.preselected << std::endl;
+   std::cout << "Time reading trees   = " << info.readSeconds << " s" << std::endl;
+   std::cout << "Time in collections  = " << info.collectionSeconds << " s" << std::endl;
+   std::cout << "Time in user code    = " << info.userSeconds << " s" << std::endl;
+   std::cout << "Files opened         = " << info.filesOpened << " in " << info.fileOpenSeconds << " s" << std::endl;
+   std::cout << "Bytes read           = " << info.bytesRead << std::endl;
+   for ( auto & tb : info.treeBytes )
+      std::cout << "   " << tb.first << ": " << info.treeZipBytes[tb.first] << " bytes read, " << tb.second << " bytes decompressed" << std::endl;
+   std::cout << "ETA                  = " << info.eta << " s" << std::endl;
+   std::cout << "=======================================================" << std::endl;
+   std::cout << std::endl;
+}
+
+// ------------ event range  ------------
+void Analysis::setRange(const int & first, const int & last)
+{
+   first_ = std::max(0, std::min(first, nevents_));
+   last_  = std::max(first_, std::min(last, nevents_));
+   rangeFirst_ = first_;
+}
+
+void Analysis::setShard(const int & k, const int & n, const bool & byBytes)
+{
+   if ( n < 1 || k < 0 || k >= n )
+   {
+      std::cout << "Invalid shard " << k << "/" << n << std::endl;
+      return;
+   }
+   std::pair<Long64_t,Long64_t> range = files_ -> shard(k, n, byBytes);
+   this -> setRange((int)range.first, (int)range.second);
+   std::cout << "Shard " << k << "/" << n << " processes the events [" << first_ << "," << last_ << ")" << std::endl;
+}
+
+void Analysis::setShard(const std::string & shard, const bool & byBytes)
+{
+   int k, n;
+   if ( sscanf(shard.c_str(), "%d/%d", &k, &n) != 2 )
+   {
+      std::cout << "Invalid shard " << shard << ", expected k/n" << std::endl;
+      return;
+   }
+   this -> setShard(k, n, byBytes);
+}
+
+void Analysis::collections_(const bool & next)
+{
+   // the collections of the trees, or those of the next event built by the reader thread
+   for ( auto & slot : slots_ )
+   {
+      if ( ! slot.tree ) continue;
+      if ( next ) slot.next       = (this ->* slot.build)(slot);
+      else        slot.collection = (this ->* slot.build)(slot);
+   }
+}
+
+// ------------ registry of trees and collections  ------------
+int Analysis::slot_(const std::string & unique_name)
+{
+   std::map<std::string, int>::iterator it = slotIndex_.find(unique_name);
+   if ( it == slotIndex_.end() ) return -1;
+   return it -> second;
+}
+
+int Analysis::addSlot_(const std::string & unique_name, const std::type_info & type)
+{
+   int index = this -> slot_(unique_name);
+   if ( index >= 0 )
+   {
+      if ( *slots_[index].type == type ) return index;
+      std::cout << "Collection " << unique_name << " already exists with another type" << std::endl;
+      return -1;
+   }
+   Slot slot;
+   slot.name  = unique_name;
+   slot.type  = &type;
+   slot.build = nullptr;
+   slot.staged = false;
+   slot.stageCollection = false;
+   slot.indexEntry = -1;
+   slot.indexOf = nullptr;
+   slot.summary = false;
+   slot.source = -1;
+   slots_.push_back(slot);
+   index = (int) slots_.size() - 1;
+   slotIndex_[unique_name] = index;
+   return index;
+}
+
+void Analysis::unstage_()
+{
+   for ( auto & slot : slots_ ) slot.staged = false;
+}
+
+// ------------ generated particles  ------------
+const GenParticleIndex & Analysis::genParticleIndex(const CollectionHandle<GenParticle> & handle)
+{
+   static const GenParticleIndex none;
+   auto particles = this -> collection(handle);
+   if ( ! particles ) return none;
+   Slot & slot = slots_[handle.index];
+   if ( ! slot.index || slot.indexEntry != entry_ || slot.indexOf != particles.get() )
+   {
+      slot.index = std::make_shared<GenParticleIndex>(particles -> objects());
+      slot.indexEntry = entry_;
+      slot.indexOf = particles.get();
+   }
+   return *std::static_pointer_cast<GenParticleIndex>(slot.index);
+}
+
+// ------------ vertex summary  ------------
+SummaryHandle<VertexSummary> Analysis::addVertexSummary(const std::string & unique_name, const std::string & path)
+{
+   // the reader thread must not be using the trees
+   this -> readerWait_();
+   decoded_ = -1;
+   // the vertex tree of the path, if already declared by addTree<Vertex>
+   int source = -1;
+   for ( size_t i = 0 ; i < slots_.size() && source < 0 ; ++i )
+      if ( slots_[i].path == path && *slots_[i].type == typeid(Vertex) && slots_[i].source < 0 ) source = i;
+   TTree * t = nullptr;
+   if ( source < 0 )
+   {
+      t = this -> treeInit_(unique_name,path);
+      if ( ! t ) return SummaryHandle<VertexSummary>();
+   }
+   int index = this -> addSlot_(unique_name, typeid(VertexSummary));
+   if ( index < 0 ) return SummaryHandle<VertexSummary>();
+   Slot & slot = slots_[index];
+   slot.path    = path;
+   slot.summary = true;
+   slot.build   = &Analysis::vertexSummary_;
+   if ( source >= 0 )
+   {
+      slot.tree   = slots_[source].tree;
+      slot.source = source;
+   }
+   else
+   {
+      slot.tree = std::make_shared< PhysicsObjectTree<Vertex> >(t, unique_name);
+      this -> treeCache_(slot.tree.get());
+   }
+   return SummaryHandle<VertexSummary>(index, unique_name);
+}
+
+const VertexSummary & Analysis::vertexSummary(const SummaryHandle<VertexSummary> & handle)
+{
+   static const VertexSummary none;
+   if ( ! handle.valid() ) return none;
+   this -> stage_(handle.index);
+   std::shared_ptr<void> & summary = slots_[handle.index].collection;
+   if ( ! summary ) return none;
+   return *std::static_pointer_cast<VertexSummary>(summary);
+}
+
+std::shared_ptr<void> Analysis::vertexSummary_(Slot & slot)
+{
+   // as treeCollection_, also called from the reader thread
+   auto tree = std::static_pointer_cast< PhysicsObjectTree<Vertex> > (slot.tree);
+   return std::make_shared<VertexSummary>(tree -> summary());
+}
+
+// ------------ checkpoint  ------------
+void Analysis::checkpointHistogram(TH1 * histogram)
+{
+   checkpointHistograms_.push_back(histogram);
+}
+
+void Analysis::checkpointCounters(const std::string & name, std::vector<unsigned int> & counters)
+{
+   checkpointCounters_[name] = &counters;
+}
+
+bool Analysis::checkpoint(const std::string & file, const int & events, const int & seconds, const std::string & config)
+{
+   checkpointFile_    = file;
+   checkpointEvents_  = events;
+   checkpointSeconds_ = seconds;
+   checkpointLast_    = first_;
+   checkpointTime_    = std::chrono::steady_clock::now();
+   checkpointElapsed_ = 0;
+   
+   // what the checkpoint is valid for, hashed with 64-bit FNV-1a, which does not
+   // depend on the compiler or the build as std::hash does
+   std::string job = config + Form("|%d|%d|",rangeFirst_,last_);
+   for ( int i = 0 ; i < files_ -> size() ; ++i )
+      job += files_ -> fileName(i) + "|";
+   unsigned long long fnv = 14695981039346656037ULL;
+   for ( auto & c : job )
+   {
+      fnv ^= (unsigned char) c;
+      fnv *= 1099511628211ULL;
+   }
+   checkpointHash_ = Form("%016llx",fnv);
+   
+   if ( ! boost::filesystem::exists(file) ) return false;
+   TDirectory::TContext context;   // the current directory of the user is kept
+   TFile * f = TFile::Open(file.c_str());
+   if ( ! f || f -> IsZombie() )
+   {
+      std::cout << "Checkpoint " << file << " cannot be read, starting from the beginning" << std::endl;
+      delete f;
+      return false;
+   }
+   TNamed * hash = (TNamed*) f -> Get("hash");
+   TParameter<int> * next = (TParameter<int>*) f -> Get("next");
+   TParameter<double> * elapsed = (TParameter<double>*) f -> Get("elapsed");
+   TParameter<int> * processed = (TParameter<int>*) f -> Get("processed");
+   if ( ! hash || ! next || std::string(hash -> GetTitle()) != checkpointHash_ )
+   {
+      std::cout << "Checkpoint " << file << " is of another job, starting from the beginning" << std::endl;
+      f -> Close();
+      delete f;
+      return false;
+   }
+   
+   // restore
+   for ( auto & h : checkpointHistograms_ )
+   {
+      TH1 * saved = (TH1*) f -> Get(h -> GetName());
+      if ( ! saved ) continue;
+      h -> Reset();
+      h -> Add(saved);
+   }
+   for ( auto & c : checkpointCounters_ )
+   {
+      TVectorD * saved = (TVectorD*) f -> Get(("counters_"+c.first).c_str());
+      if ( ! saved ) continue;
+      for ( int i = 0 ; i < saved -> GetNrows() && i < (int) c.second -> size() ; ++i )
+         c.second -> at(i) = (unsigned int) (*saved)[i];
+   }
+   first_ = std::min(next -> GetVal(), last_);
+   // the range is still that of the whole job, e.g. for the number of events it writes
+   if ( processed ) rangeFirst_ = next -> GetVal() - processed -> GetVal();
+   checkpointLast_ = first_;
+   if ( elapsed ) checkpointElapsed_ = elapsed -> GetVal();
+   f -> Close();
+   delete f;
+   
+   std::cout << "Resuming from the checkpoint " << file << " at event " << first_ << std::endl;
+   return true;
+}
+
+void Analysis::checkpointWrite_(const int & next)
+{
+   // written to a temporary file and renamed, so that there is always a complete checkpoint
+   std::string tmp = checkpointFile_ + ".tmp";
+   TDirectory::TContext context;
+   TFile * f = TFile::Open(tmp.c_str(),"RECREATE");
+   if ( ! f || f -> IsZombie() )
+   {
+      std::cout << "Checkpoint " << tmp << " cannot be written" << std::endl;
+      delete f;
+      return;
+   }
+   TNamed hash("hash",checkpointHash_.c_str());
+   TParameter<int> nextEvent("next",next);
+   TParameter<int> processed("processed",next - rangeFirst_);
+   // of the loop so far, including the runs before a resume
+   double seconds = checkpointElapsed_;
+   if ( monitorStarted_ ) seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - monitorStart_).count();
+   TParameter<double> elapsed("elapsed",seconds);
+   f -> WriteTObject(&hash);
+   f -> WriteTObject(&nextEvent);
+   f -> WriteTObject(&processed);
+   f -> WriteTObject(&elapsed);
+   for ( auto & h : checkpointHistograms_ )
+      f -> WriteTObject(h, h -> GetName());
+   for ( auto & c : checkpointCounters_ )
+   {
+      TVectorD counters((int) c.second -> size());
+      for ( size_t i = 0 ; i < c.second -> size() ; ++i )
+         counters[i] = c.second -> at(i);
+      f -> WriteTObject(&counters, ("counters_"+c.first).c_str());
+   }
+   f -> Close();
+   delete f;
+   std::rename(tmp.c_str(), checkpointFile_.c_str());
+   
+   checkpointLast_ = next;
+   checkpointTime_ = std::chrono::steady_clock::now();
+}
+
+// ------------ pipelined reading  ------------
+void Analysis::pipeline(const bool & on)
+{
+   if ( on == pipeline_ ) return;
+   if ( on )
+   {
+      if ( stagedReading_ )
+      {
+         std::cout << "Pipelined reading replaces the staged reading" << std::endl;
+         stagedReading_ = false;
+      }
+      this -> unstage_();
+      // the reader thread opens files while the user creates and fills histograms
+      ROOT::EnableThreadSafety();
+      this -> eventBranches_(true);
+      stop_      = false;
+      requested_ = -1;
+      decoded_   = -1;
+      pipeline_  = true;
+      reader_ = std::thread(&Analysis::readerLoop_, this);
+   }
+   else
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         stop_ = true;
+      }
+      condition_.notify_all();
+      reader_.join();
+      pipeline_ = false;
+      this -> eventBranches_(false);
+   }
+}
+
+void Analysis::eventBranches_(const bool & buffer)
+{
+   // event information
+   std::vector<std::string> branches = t_event_ -> branchesRead();
+   auto bind = [&](const std::string & name, void * member, void * buf)
+   {
+      if ( std::find(branches.begin(),branches.end(),name) != branches.end() )
+         t_event_ -> branch(name, buffer ? buf : member);
+   };
+   bind("event",       &event_,          &buffer_.event);
+   bind("run",         &run_,            &buffer_.run);
+   bind("lumisection", &lumi_,           &buffer_.lumi);
+   bind("nPileup",     &n_pu_,           &buffer_.nPileup);
+   bind("nTruePileup", &n_true_pu_,      &buffer_.nTruePileup);
+   bind("lumiPileup",  &lumi_pu_,        &buffer_.lumiPileup);
+   bind("instantLumi", &inst_lumi_,      &buffer_.instantLumi);
+   bind("genWeight",   &genWeight_,      &buffer_.genWeight);
+   bind("genScale",    &genScale_,       &buffer_.genScale);
+   bind("pdfid1",      &pdf_.id.first,   &buffer_.pdf.id.first);
+   bind("pdfid2",      &pdf_.id.second,  &buffer_.pdf.id.second);
+   bind("pdfx1",       &pdf_.x.first,    &buffer_.pdf.x.first);
+   bind("pdfx2",       &pdf_.x.second,   &buffer_.pdf.x.second);
    
-   for ( auto & tree : t_any_ )
+   // trigger results
+   if ( ! t_triggerResults_ ) return;
+   for ( auto & branch : t_triggerResults_ -> branchesRead() )
    {
-      std::string name = tree.first;
-      std::string type = t_type_[name];
-      if ( type == "Jet" )            this->addCollection<Jet>(name);
-      if ( type == "Muon" )           this->addCollection<Muon>(name);
-      if ( type == "GenJet" )         this->addCollection<GenJet>(name);
-      if ( type == "MET" )            this->addCollection<MET>(name);
-      if ( type == "Vertex" )         this->addCollection<Vertex>(name);
-      if ( type == "TriggerObject" )  this->addCollection<TriggerObject>(name);
-      if ( type == "GenParticle" )    this->addCollection<GenParticle>(name);
-      if ( type == "Candidate" )      this->addCollection<Candidate>(name);
-      if ( type == "JetTag" )         this->addCollection<JetTag>(name);
+      if ( TString(branch).BeginsWith("ps") )
+         t_triggerResults_ -> branch(branch, buffer ? &buffer_.triggerResultsPS[branch] : &triggerResultsPS_[branch]);
+      else
+         t_triggerResults_ -> branch(branch, buffer ? &buffer_.triggerResults[branch] : &triggerResults_[branch]);
    }
+}
+
+void Analysis::decode_(const int & event, const bool & addCollections)
+{
+   // Initialisation for backward compatibility
+   buffer_.nPileup     = -1;
+   buffer_.nTruePileup = -1;
+   buffer_.genWeight   = -1.;
+   buffer_.genScale    = -1.;
+   buffer_.pdf.id.first  = 0;
+   buffer_.pdf.id.second = 0;
+   buffer_.pdf.x.first   = -1.;
+   buffer_.pdf.x.second  = -1.;
+   
+   auto start = std::chrono::steady_clock::now();
+   Long64_t entry = files_ -> entry(event);
+   if ( files_ -> newFile() ) this -> treesReload_();
+   
+   t_event_ -> event(entry);
+   if ( t_triggerResults_ ) t_triggerResults_ -> event(entry);
+   for ( auto & slot : slots_ )
+      if ( slot.tree && slot.source < 0 ) slot.tree -> event(entry);
+   auto readEnd = std::chrono::steady_clock::now();
+   readSeconds_ += std::chrono::duration<double>(readEnd - start).count();
+   
+   for ( auto & slot : slots_ ) slot.next.reset();
+   if ( addCollections ) this -> collections_(true);
+   collectionSeconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - readEnd).count();
    
+   decoded_ = event;
+   decodedCollections_ = addCollections;
+}
+
+void Analysis::readerLoop_()
+{
+   std::unique_lock<std::mutex> lock(mutex_);
+   while ( true )
+   {
+      condition_.wait(lock, [this]{ return requested_ >= 0 || stop_; });
+      if ( stop_ ) return;
+      int  event = requested_;
+      bool addCollections = requestedCollections_;
+      lock.unlock();
+      this -> decode_(event, addCollections);
+      lock.lock();
+      requested_ = -1;
+      condition_.notify_all();
+   }
+}
+
+void Analysis::readerRequest_(const int & event, const bool & addCollections)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requested_ = event;
+      requestedCollections_ = addCollections;
+   }
+   condition_.notify_all();
+}
+
+void Analysis::readerWait_()
+{
+   if ( ! pipeline_ ) return;
+   std::unique_lock<std::mutex> lock(mutex_);
+   condition_.wait(lock, [this]{ return requested_ < 0; });
+}
+
+void Analysis::readerCurrent_()
+{
+   // the raw tree buffers hold the next event, decoded in the background;
+   // they are read again for the current event, the next one is then decoded by event()
+   if ( ! pipeline_ ) return;
+   this -> readerWait_();
+   if ( decoded_ == entry_ ) return;
+   if ( ! rereadWarned_ )
+   {
+      std::cout << "Pipelined reading: the raw trees are read again for the current event, use the collections instead" << std::endl;
+      rereadWarned_ = true;
+   }
+   this -> decode_(entry_, false);
 }
 
 
@@ -139,17 +810,54 @@ void Analysis::event(const int & event, const bool & addCollections)
 // ===========================================================
 // ===============         Trees             =================
 // ===========================================================
-void Analysis::treeInit_(const std::string & unique_name, const std::string & path)
+TTree * Analysis::treeInit_(const std::string & unique_name, const std::string & path)
+{
+   TTree * tree = files_ -> tree(path);
+   if ( ! tree )
+   {
+      std::cout << "tree " << path << " does not exist" << std::endl;
+      return nullptr;
+   }
+   return tree;
+}
+
+void Analysis::treesReload_()
 {
-   std::string treeTitle = ((TTree*) t_event_->GetFile()->Get(path.c_str())) -> GetTitle();
-   tree_[unique_name] = new TChain(path.c_str(),treeTitle.c_str());
-   tree_[unique_name] -> AddFileInfoList(fileList_);
-   t_event_ -> AddFriend(tree_[unique_name]);
+   // the same trees taken from the new file
+   t_event_ -> tree(files_ -> tree(eventInfoPath_));
+   if ( t_triggerResults_ ) t_triggerResults_ -> tree(files_ -> tree(triggerResultsPath_));
+   for ( auto & slot : slots_ )
+      if ( slot.tree && slot.source < 0 ) slot.tree -> tree(files_ -> tree(slot.path));
+
+   // the caches belong to the trees of the previous file
+   this -> treeCache_(t_event_);
+   this -> treeCache_(t_triggerResults_);
+   for ( auto & slot : slots_ )
+      if ( slot.source < 0 ) this -> treeCache_(slot.tree.get());
+}
+
+void Analysis::treeCache_(TreeBase * tree)
+{
+   if ( ! tree || ! files_ -> cache() ) return;
+   files_ -> cache(tree -> tree(), tree -> branchesRead());
+}
 
-   treeTitle.erase(std::remove(treeTitle.begin(),treeTitle.end(),' '),treeTitle.end());
-   std::string classname = treeTitle.substr(0,treeTitle.find_first_of("|"));
-   std::string inputTag  = treeTitle.substr(treeTitle.find_first_of("|")+1);
+// ------------ read cache  ------------
+void Analysis::treeCache(const Long64_t & size, const int & learnEntries, const bool & prefetch)
+{
+   this -> readerWait_();
+   files_ -> cache(size, learnEntries, prefetch);
+   // trees already declared
+   this -> treeCache_(t_event_);
+   this -> treeCache_(t_triggerResults_);
+   for ( auto & slot : slots_ )
+      if ( slot.source < 0 ) this -> treeCache_(slot.tree.get());
+}
 
+void Analysis::listTreeCache()
+{
+   this -> readerWait_();
+   files_ -> cacheReport();
 }
 // See Analysis.h for the implementations related to template trees
 
@@ -167,29 +875,31 @@ void Analysis::treeInit_(const std::string & unique_name, const std::string & pa
 
 void Analysis::triggerResults(const std::string & path)
 {
-   t_triggerResults_  = new TChain(path.c_str());
-   int ok = t_triggerResults_ -> AddFileInfoList(fileList_);
-   t_event_ -> AddFriend(t_triggerResults_);
-   if ( ok == 0 )
+   this -> readerWait_();
+   decoded_ = -1;
+   TTree * tree = files_ -> tree(path);
+   if ( ! tree )
    {
       std::cout << "tree does not exist" << std::endl;
       return;
    }
-   TObjArray * triggerBranches = t_triggerResults_ -> GetListOfBranches();
-   for ( int i = 0 ; i < triggerBranches->GetEntries() ; ++i )
+   triggerResultsPath_ = path;
+   t_triggerResults_ = new TreeBase(tree, "TriggerResults");
+   for ( auto & branch : t_triggerResults_ -> branches() )
    {
-      std::string branch = triggerBranches->At(i)->GetName();
       if ( TString(branch).BeginsWith("ps") )
       {
          triggerResultsPS_[branch] = 1;
-         t_triggerResults_ -> SetBranchAddress(branch.c_str(), &triggerResultsPS_[branch]);
+         t_triggerResults_ -> branch(branch, &triggerResultsPS_[branch]);
       }
       else
       {
          triggerResults_[branch] = 0;
-         t_triggerResults_ -> SetBranchAddress(branch.c_str(), &triggerResults_[branch]);
+         t_triggerResults_ -> branch(branch, &triggerResults_[branch]);
       }
    }
+   if ( pipeline_ ) this -> eventBranches_(true);
+   this -> treeCache_(t_triggerResults_);
 }
 
 int Analysis::triggerResult(const std::string & trig)
@@ -217,22 +927,29 @@ int Analysis::triggerHLTPrescale(const std::string & trig)
 // ------------ methods called for metadata  ------------
 void Analysis::crossSections(const std::string & path)
 {
-   t_xsection_  = new TChain(path.c_str());
-   int ok = t_xsection_ -> AddFileInfoList(fileList_);
-   if ( ok == 0 )
+   // cross sections are taken from the first file, opened on its own,
+   // so that the current file and the trees of the event loop stay as they are
+   TDirectory::TContext context;
+   TFile * f = files_ -> openFile(0);
+   TTree * tree = f ? (TTree*) f -> Get(path.c_str()) : nullptr;
+   if ( ! tree )
    {
       std::cout << "tree does not exist" << std::endl;
+      delete f;
       return;
    }
-   TObjArray * xsecBranches = t_xsection_->GetListOfBranches();
+   xsectionPath_ = path;
+   TObjArray * xsecBranches = tree->GetListOfBranches();
    for ( int i = 0 ; i < xsecBranches->GetEntries() ; ++i )
    {
       std::string branch = xsecBranches->At(i)->GetName();
       if ( branch == "run" ) continue;
       xsections_[branch] = 0;
-      t_xsection_ -> SetBranchAddress(branch.c_str(), &xsections_[branch]);
+      tree -> SetBranchAddress(branch.c_str(), &xsections_[branch]);
    }
-   t_xsection_ -> GetEntry(0);
+   tree -> GetEntry(0);
+   f -> Close();
+   delete f;
 }
 
 double Analysis::crossSection()
@@ -241,7 +958,7 @@ double Analysis::crossSection()
 }
 double Analysis::crossSection(const std::string & xs)
 {
-   if ( t_xsection_ == NULL ) return -1.;
+   if ( xsectionPath_ == "" ) return -1.;
    return xsections_[xs];
 }
 
@@ -252,10 +969,16 @@ double Analysis::luminosity()
 
 double Analysis::luminosity(const std::string & xs)
 {
-	if ( t_xsection_ == NULL ) return -1.;
+	if ( xsectionPath_ == "" ) return -1.;
 	return (nevents_ / this -> crossSection(xs));
 }
 
+double Analysis::rangeLuminosity()
+{
+   if ( xsectionPath_ == "" ) return -1.;
+   return (this -> rangeSize() / this -> crossSection());
+}
+
 float Analysis::scaleLuminosity(const float & lumi)
 {
    float lumiScale = 1.;
@@ -272,7 +995,7 @@ void   Analysis::listCrossSections()
    std::cout << "=======================================================" << std::endl;
    std::cout << "  CROSS SECTIONS" << std::endl;
    std::cout << "=======================================================" << std::endl;
-   if ( t_xsection_ == NULL )
+   if ( xsectionPath_ == "" )
    {
       std::cout << "No cross section tree has been declared." << std::endl;
       std::cout << "=======================================================" << std::endl;
@@ -292,22 +1015,33 @@ void   Analysis::listCrossSections()
 
 FilterResults Analysis::generatorFilter(const std::string & path)
 {
-   t_genfilter_  = new TChain(path.c_str());
-   t_genfilter_ -> AddFileInfoList(fileList_);
+   genfilterPath_ = path;
 
    unsigned int ntotal;
    unsigned int nfiltered;
    unsigned int sumtotal = 0;
    unsigned int sumfiltered = 0;
 
-   t_genfilter_ -> SetBranchAddress("nEventsTotal", &ntotal);
-   t_genfilter_ -> SetBranchAddress("nEventsFiltered", &nfiltered);
-
-   for ( int i = 0; i < t_genfilter_->GetEntries(); ++i )
+   // each file opened on its own, so that the current file and the trees of the event loop stay as they are
+   TDirectory::TContext context;
+   for ( int i = 0 ; i < files_ -> size() ; ++i )
    {
-      t_genfilter_ -> GetEntry(i);
-      sumtotal += ntotal;
-      sumfiltered += nfiltered;
+      TFile * f = files_ -> openFile(i);
+      TTree * tree = f ? (TTree*) f -> Get(path.c_str()) : nullptr;
+      if ( tree )
+      {
+         tree -> SetBranchAddress("nEventsTotal", &ntotal);
+         tree -> SetBranchAddress("nEventsFiltered", &nfiltered);
+
+         for ( int j = 0; j < tree->GetEntries(); ++j )
+         {
+            tree -> GetEntry(j);
+            sumtotal += ntotal;
+            sumfiltered += nfiltered;
+         }
+      }
+      if ( f ) f -> Close();
+      delete f;
    }
 
 
@@ -323,7 +1057,7 @@ void Analysis::listGeneratorFilter()
    std::cout << "=======================================================" << std::endl;
    std::cout << "  GENERATOR FILTER" << std::endl;
    std::cout << "=======================================================" << std::endl;
-   if ( t_genfilter_ == NULL )
+   if ( genfilterPath_ == "" )
    {
       std::cout << "No generator tree has been declared." << std::endl;
       std::cout << "=======================================================" << std::endl;
@@ -344,22 +1078,33 @@ void Analysis::listGeneratorFilter()
 
 FilterResults Analysis::eventFilter(const std::string & path)
 {
-   t_evtfilter_  = new TChain(path.c_str());
-   t_evtfilter_ -> AddFileInfoList(fileList_);
+   evtfilterPath_ = path;
 
    unsigned int ntotal;
    unsigned int nfiltered;
    unsigned int sumtotal = 0;
    unsigned int sumfiltered = 0;
 
-   t_evtfilter_ -> SetBranchAddress("nEventsTotal", &ntotal);
-   t_evtfilter_ -> SetBranchAddress("nEventsFiltered", &nfiltered);
-
-   for ( int i = 0; i < t_evtfilter_->GetEntries(); ++i )
+   // each file opened on its own, so that the current file and the trees of the event loop stay as they are
+   TDirectory::TContext context;
+   for ( int i = 0 ; i < files_ -> size() ; ++i )
    {
-      t_evtfilter_ -> GetEntry(i);
-      sumtotal += ntotal;
-      sumfiltered += nfiltered;
+      TFile * f = files_ -> openFile(i);
+      TTree * tree = f ? (TTree*) f -> Get(path.c_str()) : nullptr;
+      if ( tree )
+      {
+         tree -> SetBranchAddress("nEventsTotal", &ntotal);
+         tree -> SetBranchAddress("nEventsFiltered", &nfiltered);
+
+         for ( int j = 0; j < tree->GetEntries(); ++j )
+         {
+            tree -> GetEntry(j);
+            sumtotal += ntotal;
+            sumfiltered += nfiltered;
+         }
+      }
+      if ( f ) f -> Close();
+      delete f;
    }
 
 
@@ -16,6 +16,7 @@
 #include <iostream>
 // user include files
 #include "Analysis/Core/interface/Candidate.h"
+#include "Analysis/Core/interface/CandidateView.h"
 
 
 //
@@ -57,25 +58,37 @@ Candidate::~Candidate()
 //
 bool Candidate::matchTo(const std::vector<Candidate> * cands, const std::string & name, const float & deltaR)
 {
-   bool status = false;
-   
-   
    if ( ! cands )
    {
       this -> matched_[name] = nullptr;
-      return status;
+      return false;
+   }
+   return this -> matchTo(CandidateView(*cands), name, deltaR);
+}
+
+bool Candidate::matchTo(const std::vector<Candidate> * cands, const std::string & name, const float & delta_pT, const float & deltaR)
+{
+   if ( ! cands )
+   {
+      this -> matched_[name] = nullptr;
+      return false;
    }
+   return this -> matchTo(CandidateView(*cands), name, delta_pT, deltaR);
+}
 
-   const Candidate * cand = nullptr;
+bool Candidate::matchTo(const CandidateView & cands, const std::string & name, const float & deltaR)
+{
+   bool status = false;
+   
    const Candidate * nearcand = nullptr;
    float minDeltaR = 100.;
-   for ( size_t i = 0; i < cands->size() ; ++i )
+   for ( auto & cand : cands )
    {
-      cand = &(cands->at(i));
-      if(this->deltaR(*cand) < minDeltaR)
+      float dR = this->deltaR(cand);
+      if(dR < minDeltaR)
       {
-         minDeltaR = this->deltaR(*cand);
-         nearcand = cand;
+         minDeltaR = dR;
+         nearcand = &cand;
       }
    }
 	
@@ -92,31 +105,23 @@ bool Candidate::matchTo(const std::vector<Candidate> * cands, const std::string
    return status;
 }
 
-bool Candidate::matchTo(const std::vector<Candidate> * cands, const std::string & name, const float & delta_pT, const float & deltaR)
+bool Candidate::matchTo(const CandidateView & cands, const std::string & name, const float & delta_pT, const float & deltaR)
 {
    bool status = false;
 
-
-   if ( ! cands )
-   {
-      this -> matched_[name] = nullptr;
-      return status;
-   }
-
-   const Candidate * cand = nullptr;
    const Candidate * nearcand = nullptr;
    float minDeltaR = deltaR + 1; 		// Assign more real value;
    float dpT = 0.;
    float dpTmin = delta_pT + 1;
-   for ( size_t i = 0; i < cands->size() ; ++i )
+   for ( auto & cand : cands )
    {
-      cand = &(cands->at(i));
-      dpT = std::abs(this->pt() - cand->pt());
-      if(this->deltaR(*cand) < minDeltaR && dpT < dpTmin)
+      dpT = std::abs(this->pt() - cand.pt());
+      float dR = this->deltaR(cand);
+      if(dR < minDeltaR && dpT < dpTmin)
       {
-         minDeltaR = this->deltaR(*cand);
+         minDeltaR = dR;
          dpTmin    = dpT;
-         nearcand = cand;
+         nearcand = &cand;
       }
    }
 
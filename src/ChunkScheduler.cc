@@ -0,0 +1,109 @@
+/**\class ChunkScheduler ChunkScheduler.cc Analysis/Core/src/ChunkScheduler.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:15:30 GMT
+//
+//
+
+// system include files
+#include <iostream>
+#include <algorithm>
+//
+// user include files
+#include "Analysis/Core/interface/ChunkScheduler.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+ChunkScheduler::ChunkScheduler(FileManager * files, const Long64_t & first, const Long64_t & last, const int & workers)
+{
+   // one chunk per cluster of the event tree within the range
+   std::vector<Chunk> chunks;
+   for ( int i = 0 ; i < files -> size() ; ++i )
+   {
+      Long64_t offset  = files -> offset(i);
+      Long64_t entries = files -> entries(i);
+      if ( entries == 0 || offset + entries <= first || offset >= last ) continue;
+      std::vector<Long64_t> starts = files -> clusters(i);
+      if ( starts.empty() ) starts.push_back(0);
+      for ( size_t c = 0 ; c < starts.size() ; ++c )
+      {
+         Long64_t begin = std::max(offset + starts[c], first);
+         Long64_t end   = std::min(offset + ( c+1 < starts.size() ? starts[c+1] : entries ), last);
+         if ( begin < end ) chunks.push_back(Chunk(begin,end));
+      }
+   }
+   nchunks_   = (int) chunks.size();
+   remaining_ = nchunks_;
+
+   // contiguous blocks of chunks, so that each worker starts in its own files
+   int n = std::max(workers,1);
+   queues_.resize(n);
+   stolen_.assign(n,0);
+   for ( int w = 0 ; w < n ; ++w )
+   {
+      mutexes_.push_back(std::unique_ptr<std::mutex>(new std::mutex));
+      size_t begin = (size_t) chunks.size() *  w    / n;
+      size_t end   = (size_t) chunks.size() * (w+1) / n;
+      queues_[w].assign(chunks.begin()+begin, chunks.begin()+end);
+   }
+}
+
+ChunkScheduler::~ChunkScheduler()
+{
+}
+
+
+//
+// member functions
+//
+bool ChunkScheduler::next(const int & worker, Chunk & chunk)
+{
+   // own queue
+   {
+      std::lock_guard<std::mutex> lock(*mutexes_[worker]);
+      if ( ! queues_[worker].empty() )
+      {
+         chunk = queues_[worker].front();
+         queues_[worker].pop_front();
+         --remaining_;
+         return true;
+      }
+   }
+
+   // steal from the back of the longest queue, i.e. the work its owner would reach last
+   while ( remaining_ > 0 )
+   {
+      int victim = -1;
+      size_t longest = 0;
+      for ( int w = 0 ; w < (int) queues_.size() ; ++w )
+      {
+         if ( w == worker ) continue;
+         std::lock_guard<std::mutex> lock(*mutexes_[w]);
+         if ( queues_[w].size() > longest )
+         {
+            longest = queues_[w].size();
+            victim  = w;
+         }
+      }
+      if ( victim < 0 ) return false;
+
+      std::lock_guard<std::mutex> lock(*mutexes_[victim]);
+      if ( queues_[victim].empty() ) continue;   // emptied meanwhile, look again
+      chunk = queues_[victim].back();
+      queues_[victim].pop_back();
+      --remaining_;
+      ++stolen_[worker];
+      return true;
+   }
+   return false;
+}
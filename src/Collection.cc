@@ -32,8 +32,9 @@
 namespace analysis {
    namespace tools {
       template <> Collection<Vertex>::Collection(const Objects & objects, const std::string & name);
-      template <> std::vector<Candidate> * Collection<Vertex>::vectorCandidates() const;
-      template <> void Collection<Vertex>::matchTo( const std::vector<Candidate>* vectorcandidates, const std::string & name, const float & deltaR );
+      template <> Collection<Vertex>::Collection(Objects && objects, const std::string & name);
+      template <> CandidateView Collection<Vertex>::candidates() const;
+      template <> void Collection<Vertex>::matchTo( const CandidateView & candidates, const std::string & name, const float & deltaR );
       template <> void Collection<Vertex>::matchTo( const Collection<Candidate> & collection, const float & deltaR );
       template <> void Collection<Vertex>::matchTo( const Collection<Candidate> & collection, const float & deltaR, const float & delta_pt);
       template <> void Collection<Vertex>::matchTo( const Collection<TriggerObject> & collection, const float & deltaR );
@@ -42,6 +43,8 @@ namespace analysis {
       template <> void Collection<Jet>::associatePartons( const std::shared_ptr<Collection<GenParticle> > & particles, const float & deltaR, const float & ptMin, const bool & pythia8  );
       template <> void Collection<Jet>::btagAlgo( const std::string & algo );
       template <> void Collection<Jet>::smearTo(const Collection<Jet> & collection, const double & n_sigma );
+      template <> void Collection<Jet>::smearTo(const Collection<Jet> & collection, const RandomStream & random, const double & n_sigma );
+      template <> void Collection<Jet>::smear_(const Collection<Jet> & collection, const double & n_sigma, const RandomStream * random );
    }
 }
 //
@@ -51,7 +54,7 @@ namespace analysis {
 using namespace analysis;
 using namespace analysis::tools;
 
-bool pTordering(Candidate j1, Candidate j2) {return (j1.pt()>j2.pt());}
+bool pTordering(const Candidate & j1, const Candidate & j2) {return (j1.pt()>j2.pt());}
 
 //
 // constructors and destructor
@@ -60,7 +63,6 @@ template <class Object>
 Collection<Object>::Collection()
 {
 	size_ = 0;
-	candidates_.clear();
 }
 template <class Object>
 Collection<Object>::Collection(const Objects & objects, const std::string & name)
@@ -68,8 +70,13 @@ Collection<Object>::Collection(const Objects & objects, const std::string & name
    objects_ = objects;
    size_ = (int) objects_.size();
    name_ = name;
-   candidates_.clear();
-   for ( int i = 0; i < size_ ; ++i ) candidates_.push_back(objects_[i]);
+}
+template <class Object>
+Collection<Object>::Collection(Objects && objects, const std::string & name)
+{
+   objects_ = std::move(objects);
+   size_ = (int) objects_.size();
+   name_ = name;
 }
 
 template <>
@@ -79,6 +86,13 @@ Collection<Vertex>::Collection(const Objects & objects, const std::string & name
    size_ = (int) objects_.size();
    name_ = name;
 }
+template <>
+Collection<Vertex>::Collection(Objects && objects, const std::string & name)
+{
+   objects_ = std::move(objects);
+   size_ = (int) objects_.size();
+   name_ = name;
+}
 
 
 template <class Object>
@@ -94,17 +108,14 @@ Collection<Object>::~Collection()
 //
 // member functions
 //
-//template <class Object>
-//std::vector<Object> * Collection<Object>::vector()
 template <class Object>
-std::vector< std::shared_ptr<Object> >  Collection<Object>::vector()
+std::vector<Object> Collection<Object>::release()
 {
-   std::vector< std::shared_ptr<Object> > objects;
-   for ( auto & obj : objects_ )
-   {
-      std::shared_ptr<Object> sp_obj = std::shared_ptr<Object> ( new Object(obj));
-      objects.push_back(sp_obj);
-   }
+   Objects objects(std::move(objects_));
+   objects_.clear();
+   size_ = 0;
+   // nothing points into the other collections any more
+   dependsOn_.clear();
    return objects;
 }
 template <class Object>
@@ -127,10 +138,13 @@ template <>
 void Collection<Jet>::associatePartons(const std::shared_ptr<Collection<GenParticle> > & particles, const float & deltaR, const float & ptMin, const bool & pythia8  )
 {
    if ( objects_.size() < 1 ) return;
-   auto vec = particles->vector();
+   // the partons of the jets point into the particles
+   this -> dependsOn(particles);
+   // the particles are sorted once, each jet then looks only at the partons
+   GenParticleIndex index(particles->objects());
    
    for ( auto & jet : objects_ )
-      jet.associatePartons(vec,deltaR,ptMin,pythia8);
+      jet.associatePartons(index,deltaR,ptMin,pythia8);
    
    // resolving ambiguities
    // if a parton belongs to more than one jet, than remove it 
@@ -183,30 +197,30 @@ void Collection<Jet>::associatePartons(const std::shared_ptr<Collection<GenParti
 
 
 template <class Object>
-void Collection<Object>::matchTo( const std::vector<Candidate>* vectorcandidates, const std::string & name, const float & deltaR )
+void Collection<Object>::matchTo( const CandidateView & candidates, const std::string & name, const float & deltaR )
 {
    for ( auto & obj : objects_ )
-      obj.matchTo(vectorcandidates,name,deltaR);
+      obj.matchTo(candidates,name,deltaR);
 }
 
 template <class Object>
 void Collection<Object>::matchTo( const Collection<Candidate> & collection, const float & deltaR )
 {
    for ( auto & obj : objects_ )
-      obj.matchTo(collection.vectorCandidates(),collection.name(), deltaR);
+      obj.matchTo(collection.candidates(),collection.name(), deltaR);
 }
 
 template <class Object>
 void Collection<Object>::matchTo( const Collection<Candidate> & collection, const float & delta_pT, const float & deltaR){
 	for (auto & obj : objects_){
-		obj.matchTo(collection.vectorCandidates(),collection.name(),delta_pT,deltaR);
+		obj.matchTo(collection.candidates(),collection.name(),delta_pT,deltaR);
 	}
 }
 
 template <>
 void Collection<Jet>::matchTo( const Collection<Jet> & collection, const float & delta_pT, const float & deltaR){
 	for (auto & obj : objects_){
-		obj.matchTo(collection.vectorCandidates(),collection.name(),delta_pT*obj.JerResolution()*obj.pt(),deltaR);
+		obj.matchTo(collection.candidates(),collection.name(),delta_pT*obj.JerResolution()*obj.pt(),deltaR);
 	}
 }
 
@@ -214,37 +228,44 @@ template <class Object>
 void Collection<Object>::matchTo( const Collection<TriggerObject> & collection, const float & deltaR )
 {
    for ( auto & obj : objects_ )
-      obj.matchTo(collection.vectorCandidates(),collection.name(),deltaR);
+      obj.matchTo(collection.candidates(),collection.name(),deltaR);
 }
 
 template <class Object>
 void Collection<Object>::matchTo( const std::shared_ptr<Collection<TriggerObject> > collection, const float & deltaR )
 {
+   this->dependsOn(collection);
    this->matchTo(*collection, deltaR);
 }
 
 template <>
 void Collection<Jet>::smearTo( const Collection<Jet> & collection, const double & n_sigma  ){
+	// random numbers from gRandom, depending on the order of the events
+	this -> smear_(collection, n_sigma, nullptr);
+}
+
+template <>
+void Collection<Jet>::smearTo( const Collection<Jet> & collection, const RandomStream & random, const double & n_sigma  ){
+	this -> smear_(collection, n_sigma, &random);
+}
+
+template <>
+void Collection<Jet>::smear_( const Collection<Jet> & collection, const double & n_sigma, const RandomStream * random ){
 
 	//Check for variation - n_sigma:
 	// +1 : 1 Sigma Up variation -1 : 1 Sigma Down variation
 	// +2 : 2 Sigma Up variation -2	: 2 Sigma Down variation
-	//TODO!
-	//Very temprorary solution. Should be changed to jerSf(n_sigma)
-	// and return already a variation, but could be a conflict with
-	// setter...!!!
 
 	TLorentzVector out;
 	double smear_pt = 0;
 	double smear_e  = 0;
 	double sf = 0;
-	for(auto & jet : objects_){
-		if(n_sigma >= 0){
-			sf = n_sigma * (jet.JerSfUp() - jet.JerSf()) +  jet.JerSf();
-		}
-		else if (n_sigma < 0){
-			sf = std::abs(n_sigma) * (jet.JerSfDown() - jet.JerSf()) +  jet.JerSf();
-		}
+	// the normals of each jet for pt and energy, by its index before the re-ordering
+	std::vector<double> gaus_pt, gaus_e;
+	if ( random ) random -> gaus(objects_.size(), gaus_pt, gaus_e);
+	for(size_t j = 0 ; j < objects_.size() ; ++j){
+		Jet & jet = objects_[j];
+		sf = jet.JerSfVariation(n_sigma);
 //		std::cout<<"\nBefore smearing: "<<jet.px()<<" "<<jet.py()<<" "<<jet.pt()<<std::endl;
 		if(jet.matched(collection.name())){
 			smear_pt = jet.matched(collection.name())->pt() + sf * (jet.pt() - jet.matched(collection.name())->pt());
@@ -256,8 +277,15 @@ void Collection<Jet>::smearTo( const Collection<Jet> & collection, const double
 		}
 		else {
 			if(sf > 1) {
-				smear_pt = gRandom->Gaus(jet.pt(),std::sqrt(sf*sf-1)*jet.JerResolution()*jet.pt());
-				smear_e = gRandom->Gaus(jet.e(),std::sqrt(sf*sf-1)*jet.JerResolution()*jet.pt());
+				double sigma = std::sqrt(sf*sf-1)*jet.JerResolution()*jet.pt();
+				if ( random ) {
+					smear_pt = jet.pt() + sigma * gaus_pt[j];
+					smear_e  = jet.e()  + sigma * gaus_e[j];
+				}
+				else {
+					smear_pt = gRandom->Gaus(jet.pt(),sigma);
+					smear_e = gRandom->Gaus(jet.e(),sigma);
+				}
 			}
 			else {
 				smear_pt = jet.pt();
@@ -274,18 +302,18 @@ void Collection<Jet>::smearTo( const Collection<Jet> & collection, const double
 }
 
 template <class Object>
-std::vector<Candidate>* Collection<Object>::vectorCandidates() const
+CandidateView Collection<Object>::candidates() const
 {
-   return &candidates_;
+   return CandidateView(objects_);
 }
 
 // try to find how the enable_if works to avoid this specialization
 // typename std::enable_if<std::is_base_of<Candidate, Object>::value, std::vector<Candidate>* >::type
 // std::is_base_of<Foo, Bar>::value
 template <>
-std::vector<Candidate> * Collection<Vertex>::vectorCandidates() const
+CandidateView Collection<Vertex>::candidates() const
 {
-   return nullptr;
+   return CandidateView();
 }
 // ------------ method called for each event  ------------
 
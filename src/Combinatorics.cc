@@ -0,0 +1,118 @@
+/**\class Combinatorics Combinatorics.cc Analysis/Core/src/Combinatorics.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:48:31 GMT
+//
+//
+
+// system include files
+#include <cmath>
+#include <limits>
+#include <algorithm>
+//
+// user include files
+#include "Analysis/Core/interface/Combinatorics.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+Combinatorics::Combinatorics()
+{
+}
+
+Combinatorics::~Combinatorics()
+{
+   // do anything here that needs to be done at desctruction time
+   // (e.g. close files, deallocate resources etc.)
+}
+
+//
+// member functions
+//
+float Combinatorics::mass(const std::vector<size_t> & objects) const
+{
+   double px = 0, py = 0, pz = 0, e = 0;
+   for ( auto & i : objects )
+   {
+      px += px_[i];
+      py += py_[i];
+      pz += pz_[i];
+      e  += e_[i];
+   }
+   double m2 = e*e - px*px - py*py - pz*pz;
+   return m2 > 0 ? std::sqrt(m2) : 0;
+}
+
+float Combinatorics::minDeltaR() const
+{
+   if ( deltaR_.empty() ) return std::numeric_limits<float>::max();
+   return *std::min_element(deltaR_.begin(), deltaR_.end());
+}
+
+void Combinatorics::add_(const Candidate & candidate)
+{
+   px_.push_back(candidate.px());
+   py_.push_back(candidate.py());
+   pz_.push_back(candidate.pz());
+   e_.push_back(candidate.e());
+   eta_.push_back(candidate.eta());
+   phi_.push_back(candidate.phi());
+}
+
+void Combinatorics::kinematics_()
+{
+   size_t n  = e_.size();
+   size_t np = n < 2 ? 0 : n*(n-1)/2;
+   first_.resize(np);
+   second_.resize(np);
+   for ( size_t i = 0, p = 0 ; i+1 < n ; ++i )
+      for ( size_t j = i+1 ; j < n ; ++j, ++p )
+      {
+         first_[p]  = i;
+         second_[p] = j;
+      }
+
+   mass_.resize(np);
+   deltaR_.resize(np);
+   deltaEta_.resize(np);
+   deltaPhi_.resize(np);
+
+   // the pair sums and differences, gathered into columns so that the loops below have no indirection
+   std::vector<float> px(np), py(np), pz(np), e(np);
+   for ( size_t p = 0 ; p < np ; ++p )
+   {
+      const unsigned short i = first_[p];
+      const unsigned short j = second_[p];
+      px[p] = px_[i] + px_[j];
+      py[p] = py_[i] + py_[j];
+      pz[p] = pz_[i] + pz_[j];
+      e[p]  = e_[i]  + e_[j];
+      deltaEta_[p] = eta_[i] - eta_[j];
+      deltaPhi_[p] = tools::deltaPhi(phi_[i], phi_[j]);
+   }
+
+   float * m    = mass_.data();
+   float * dr   = deltaR_.data();
+   float * deta = deltaEta_.data();
+   float * dphi = deltaPhi_.data();
+   for ( size_t p = 0 ; p < np ; ++p )
+   {
+      float m2 = e[p]*e[p] - px[p]*px[p] - py[p]*py[p] - pz[p]*pz[p];
+      m[p] = std::sqrt(std::max(m2, 0.f));
+   }
+   for ( size_t p = 0 ; p < np ; ++p )
+      dr[p] = std::sqrt(deta[p]*deta[p] + dphi[p]*dphi[p]);
+}
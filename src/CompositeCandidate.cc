@@ -0,0 +1,88 @@
+/**\class CompositeCandidate CompositeCandidate.cc Analysis/Core/src/CompositeCandidate.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:49:23 GMT
+//
+//
+
+// system include files
+#include <cmath>
+//
+// user include files
+#include "Analysis/Core/interface/CompositeCandidate.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+CompositeCandidate::CompositeCandidate() : Candidate()
+{
+   m_  = 0;
+   pt_ = 0;
+   mCached_  = true;
+   ptCached_ = true;
+}
+
+CompositeCandidate::~CompositeCandidate()
+{
+}
+
+//
+// member functions
+//
+float CompositeCandidate::m() const
+{
+   if ( ! mCached_ )
+   {
+      m_ = Candidate::m();
+      mCached_ = true;
+   }
+   return m_;
+}
+
+float CompositeCandidate::pt() const
+{
+   if ( ! ptCached_ )
+   {
+      pt_ = std::sqrt(this->px()*this->px() + this->py()*this->py());
+      ptCached_ = true;
+   }
+   return pt_;
+}
+
+void CompositeCandidate::addDaughter_(const Candidate & daughter, const unsigned int & index)
+{
+   daughters_.push_back(&daughter);
+   indices_.push_back(index);
+}
+
+void CompositeCandidate::sum_()
+{
+   // the components, without building a TLorentzVector per daughter
+   double px = 0, py = 0, pz = 0, e = 0;
+   int q = 0;
+   for ( auto & d : daughters_ )
+   {
+      px += d -> px();
+      py += d -> py();
+      pz += d -> pz();
+      e  += d -> e();
+      q  += d -> q();
+   }
+   p4_.SetPxPyPzE(px,py,pz,e);
+   q_ = q;
+   mCached_  = false;
+   ptCached_ = false;
+}
@@ -0,0 +1,118 @@
+/**\class DeltaRMatrix DeltaRMatrix.cc Analysis/Core/src/DeltaRMatrix.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:51:01 GMT
+//
+//
+
+// system include files
+#include <cmath>
+#include <limits>
+//
+// user include files
+#include "Analysis/Core/interface/DeltaRMatrix.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+DeltaRMatrix::DeltaRMatrix() : symmetric_(true)
+{
+}
+
+DeltaRMatrix::~DeltaRMatrix()
+{
+}
+
+//
+// member functions
+//
+void DeltaRMatrix::row_(const float & eta, const float & phi, const float * etas, const float * phis, const size_t & n, float * out)
+{
+   for ( size_t j = 0 ; j < n ; ++j )
+      out[j] = tools::deltaR2(eta, phi, etas[j], phis[j]);
+}
+
+void DeltaRMatrix::fill_()
+{
+   size_t n = rowEta_.size();
+   if ( symmetric_ )
+   {
+      deltaR2_.resize(n < 2 ? 0 : n*(n-1)/2);
+      float * out = deltaR2_.data();
+      // row i of the upper triangle is contiguous: the objects i+1..n-1
+      for ( size_t i = 0 ; i+1 < n ; ++i )
+      {
+         row_(rowEta_[i], rowPhi_[i], &rowEta_[i+1], &rowPhi_[i+1], n-i-1, out);
+         out += n-i-1;
+      }
+      return;
+   }
+   size_t m = colEta_.size();
+   deltaR2_.resize(n*m);
+   for ( size_t i = 0 ; i < n ; ++i )
+      row_(rowEta_[i], rowPhi_[i], colEta_.data(), colPhi_.data(), m, &deltaR2_[i*m]);
+}
+
+float DeltaRMatrix::minDeltaR2() const
+{
+   if ( deltaR2_.empty() ) return std::numeric_limits<float>::max();
+   return *std::min_element(deltaR2_.begin(), deltaR2_.end());
+}
+
+std::vector<float> DeltaRMatrix::minDeltaR2PerObject() const
+{
+   size_t n = this -> rows();
+   size_t m = this -> columns();
+   std::vector<float> mins(n, std::numeric_limits<float>::max());
+   if ( ! symmetric_ )
+   {
+      for ( size_t i = 0 ; i < n ; ++i )
+         for ( size_t j = 0 ; j < m ; ++j )
+            mins[i] = std::min(mins[i], deltaR2_[i*m + j]);
+      return mins;
+   }
+   // each pair is the smallest candidate of both of its objects
+   size_t p = 0;
+   for ( size_t i = 0 ; i+1 < n ; ++i )
+      for ( size_t j = i+1 ; j < n ; ++j, ++p )
+      {
+         mins[i] = std::min(mins[i], deltaR2_[p]);
+         mins[j] = std::min(mins[j], deltaR2_[p]);
+      }
+   return mins;
+}
+
+size_t DeltaRMatrix::nWithin(const size_t & i, const float & dRmax) const
+{
+   const float dR2max = dRmax*dRmax;
+   size_t nwithin = 0;
+   for ( size_t j = 0 ; j < this -> columns() ; ++j )
+   {
+      if ( symmetric_ && j == i ) continue;
+      if ( this -> deltaR2(i,j) < dR2max ) ++nwithin;
+   }
+   return nwithin;
+}
+
+std::vector<bool> DeltaRMatrix::isolated(const float & dRmax) const
+{
+   const float dR2max = dRmax*dRmax;
+   std::vector<float> mins = this -> minDeltaR2PerObject();
+   std::vector<bool> iso(mins.size());
+   for ( size_t i = 0 ; i < mins.size() ; ++i )
+      iso[i] = mins[i] >= dR2max;
+   return iso;
+}
@@ -0,0 +1,343 @@
+/**\class FileManager FileManager.cc Analysis/Core/src/FileManager.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:00:08 GMT
+//
+//
+
+// system include files
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+//
+// user include files
+#include "TFileInfo.h"
+#include "TUrl.h"
+#include "TEnv.h"
+#include "TTreeCache.h"
+#include "Analysis/Core/interface/FileManager.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+FileManager::FileManager(TCollection * fileList, const std::string & eventTree)
+{
+   eventTree_ = eventTree;
+   file_      = nullptr;
+   index_     = -1;
+   newFile_   = false;
+   changed_   = false;
+   nentries_  = 0;
+
+   cache_         = false;
+   cachesize_     = 0;
+   cachelearn_    = 0;
+   cacheprefetch_ = false;
+   bytesRead_     = 0;
+   readCalls_     = 0;
+
+   filesOpened_     = 0;
+   fileOpenSeconds_ = 0;
+
+   TIter next(fileList);
+   while ( TFileInfo * info = (TFileInfo*) next() )
+      fileNames_.push_back(info->GetCurrentUrl()->GetUrl());
+
+   entries_.assign(fileNames_.size(),0);
+   offsets_.assign(fileNames_.size(),0);
+   bytes_.assign(fileNames_.size(),0);
+   clusters_.resize(fileNames_.size());
+
+   // Count the entries of the event tree in each file and find its clusters.
+   // Go backwards, so that the first file is left open for the event loop.
+   for ( int i = this->size()-1 ; i >= 0 ; --i )
+   {
+      TTree * t = this->tree(i,eventTree_);
+      if ( ! t ) continue;
+      entries_[i] = t -> GetEntries();
+      bytes_[i]   = file_ -> GetSize();
+      TTree::TClusterIterator clusters = t -> GetClusterIterator(0);
+      Long64_t start;
+      while ( (start = clusters.Next()) < entries_[i] )
+         clusters_[i].push_back(start);
+   }
+   for ( size_t i = 0 ; i < entries_.size() ; ++i )
+   {
+      offsets_[i] = nentries_;
+      nentries_ += entries_[i];
+   }
+}
+
+FileManager::FileManager(const FileManager & files)
+{
+   fileNames_ = files.fileNames_;
+   eventTree_ = files.eventTree_;
+   entries_   = files.entries_;
+   offsets_   = files.offsets_;
+   nentries_  = files.nentries_;
+   bytes_     = files.bytes_;
+   clusters_  = files.clusters_;
+   file_      = nullptr;
+   index_     = -1;
+   newFile_   = false;
+   changed_   = false;
+
+   cache_         = files.cache_;
+   cachesize_     = files.cachesize_;
+   cachelearn_    = files.cachelearn_;
+   cacheprefetch_ = files.cacheprefetch_;
+   bytesRead_     = 0;
+   readCalls_     = 0;
+
+   filesOpened_     = 0;
+   fileOpenSeconds_ = 0;
+}
+
+FileManager::~FileManager()
+{
+   trees_.clear();
+   cached_.clear();
+   if ( file_ )
+   {
+      file_ -> Close();
+      delete file_;
+   }
+}
+
+
+//
+// member functions
+//
+TFile * FileManager::file(const int & index)
+{
+   if ( index == index_ ) return file_;
+
+   // the trees (and their caches) belong to the file and are deleted with it
+   this -> cacheStats_(bytesRead_,readCalls_,cacheBytes_,noCacheBytes_);
+   trees_.clear();
+   cached_.clear();
+   if ( file_ )
+   {
+      file_ -> Close();
+      delete file_;
+      file_ = nullptr;
+   }
+   index_   = index;
+   changed_ = true;
+   if ( index < 0 || index >= this->size() ) return file_;
+
+   auto start = std::chrono::steady_clock::now();
+   file_ = TFile::Open(fileNames_[index].c_str());
+   fileOpenSeconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   ++filesOpened_;
+   if ( ! file_ || file_ -> IsZombie() )
+   {
+      std::cout << "FileManager: cannot open file " << fileNames_[index] << std::endl;
+      delete file_;
+      file_ = nullptr;
+   }
+   return file_;
+}
+
+TFile * FileManager::openFile(const int & index)
+{
+   if ( index < 0 || index >= this->size() ) return nullptr;
+   TFile * f = TFile::Open(fileNames_[index].c_str());
+   if ( ! f || f -> IsZombie() )
+   {
+      std::cout << "FileManager: cannot open file " << fileNames_[index] << std::endl;
+      delete f;
+      return nullptr;
+   }
+   return f;
+}
+
+TTree * FileManager::tree(const std::string & path)
+{
+   if ( ! file_ ) return nullptr;
+   auto it = trees_.find(path);
+   if ( it != trees_.end() ) return it->second;
+
+   TTree * t = (TTree*) file_ -> Get(path.c_str());
+   trees_[path] = t;
+   return t;
+}
+
+TTree * FileManager::tree(const int & index, const std::string & path)
+{
+   this -> file(index);
+   return this -> tree(path);
+}
+
+int FileManager::fileIndex(const Long64_t & entry)
+{
+   // first file whose range ends after the entry (empty files are skipped)
+   auto it = std::upper_bound(offsets_.begin(),offsets_.end(),entry);
+   int index = (int) std::distance(offsets_.begin(),it) - 1;
+   if ( index < 0 ) return -1;
+   while ( index < this->size()-1 && entry >= offsets_[index] + entries_[index] ) ++index;
+   return index;
+}
+
+Long64_t FileManager::entry(const Long64_t & entry)
+{
+   int index = index_;
+   // most of the time the entry is in the current file
+   if ( index < 0 || entry < offsets_[index] || entry >= offsets_[index] + entries_[index] )
+      index = this -> fileIndex(entry);
+   if ( index < 0 ) return -1;
+
+   // the file may also have been changed outside the event loop
+   this -> file(index);
+   newFile_ = changed_;
+   changed_ = false;
+   return entry - offsets_[index];
+}
+
+// ------------ shards  ------------
+std::pair<Long64_t,Long64_t> FileManager::shard(const int & k, const int & n, const bool & byBytes)
+{
+   return std::make_pair(this -> shardBoundary_(k,n,byBytes), this -> shardBoundary_(k+1,n,byBytes));
+}
+
+Long64_t FileManager::shardBoundary_(const int & k, const int & n, const bool & byBytes)
+{
+   if ( k <= 0 ) return 0;
+   if ( k >= n ) return nentries_;
+
+   // the cluster boundary closest to the k-th fraction of the entries or bytes;
+   // the bytes of a file are taken as evenly spread over its entries
+   double total = 0;
+   for ( int i = 0 ; i < this->size() ; ++i )
+      total += byBytes ? bytes_[i] : entries_[i];
+   double target = total * k / n;
+
+   Long64_t best = nentries_;
+   double   bestDistance = total - target;
+   double   before = 0;
+   for ( int i = 0 ; i < this->size() ; ++i )
+   {
+      if ( entries_[i] == 0 ) continue;
+      double perEntry = byBytes ? double(bytes_[i])/entries_[i] : 1.;
+      for ( auto & c : clusters_[i] )
+      {
+         double w = before + c * perEntry;
+         if ( fabs(w - target) < bestDistance )
+         {
+            best = offsets_[i] + c;
+            bestDistance = fabs(w - target);
+         }
+         if ( w > target ) return best;
+      }
+      before += entries_[i] * perEntry;
+   }
+   return best;
+}
+
+// ------------ monitoring  ------------
+Long64_t FileManager::bytesRead()
+{
+   return bytesRead_ + ( file_ ? file_ -> GetBytesRead() : 0 );
+}
+
+// ------------ read cache  ------------
+void FileManager::cache(const Long64_t & size, const int & learn, const bool & prefetch)
+{
+   cache_         = true;
+   cachesize_     = size;
+   cachelearn_    = learn;
+   cacheprefetch_ = prefetch;
+   // prefetching is decided when the cache is created
+   if ( prefetch ) gEnv -> SetValue("TFile.AsyncPrefetching", 1);
+}
+
+void FileManager::cache(TTree * tree, const std::vector<std::string> & branches)
+{
+   if ( ! cache_ || ! tree || ! file_ ) return;
+
+   Long64_t size = this -> cacheSize_(tree,branches);
+   if ( size <= 0 ) return;
+   tree -> SetCacheSize(size);
+   if ( cachelearn_ > 0 )
+   {
+      // the cache finds out by itself which branches are read
+      tree -> SetCacheLearnEntries(cachelearn_);
+   }
+   else
+   {
+      for ( auto & branch : branches )
+         tree -> AddBranchToCache(branch.c_str(), true);
+      tree -> StopCacheLearningPhase();
+   }
+   for ( auto & t : trees_ )
+      if ( t.second == tree ) cached_.insert(t.first);
+}
+
+Long64_t FileManager::cacheSize_(TTree * tree, const std::vector<std::string> & branches)
+{
+   if ( cachesize_ > 0 ) return cachesize_;
+
+   // enough to hold one cluster of the branches to be read
+   Long64_t entries = tree -> GetEntries();
+   if ( entries <= 0 ) return 0;
+   TTree::TClusterIterator clusters = tree -> GetClusterIterator(0);
+   Long64_t start = clusters.Next();
+   Long64_t clusterEntries = std::min(clusters.GetNextEntry() - start, entries);
+   if ( clusterEntries <= 0 ) clusterEntries = entries;
+
+   Long64_t zipBytes = 0;
+   for ( auto & branch : branches )
+   {
+      TBranch * b = tree -> GetBranch(branch.c_str());
+      if ( b ) zipBytes += b -> GetZipBytes("*");
+   }
+   Long64_t size = (Long64_t) (1.25 * zipBytes * clusterEntries / entries);
+   return std::max(size, (Long64_t) 256*1024);
+}
+
+void FileManager::cacheStats_(Long64_t & bytesRead, Long64_t & readCalls, std::map<std::string, Long64_t> & cacheBytes, std::map<std::string, Long64_t> & noCacheBytes)
+{
+   if ( ! file_ ) return;
+   bytesRead += file_ -> GetBytesRead();
+   readCalls += file_ -> GetReadCalls();
+   for ( auto & path : cached_ )
+   {
+      TFileCacheRead * tc = file_ -> GetCacheRead(trees_[path]);
+      if ( ! tc ) continue;
+      cacheBytes[path]   += tc -> GetBytesRead();
+      noCacheBytes[path] += tc -> GetNoCacheBytesRead();
+   }
+}
+
+void FileManager::cacheReport()
+{
+   // include the file that is still open
+   Long64_t bytesRead = bytesRead_;
+   Long64_t readCalls = readCalls_;
+   std::map<std::string, Long64_t> cacheBytes   = cacheBytes_;
+   std::map<std::string, Long64_t> noCacheBytes = noCacheBytes_;
+   this -> cacheStats_(bytesRead,readCalls,cacheBytes,noCacheBytes);
+
+   std::cout << "=======================================================" << std::endl;
+   std::cout << "  READ CACHE" << std::endl;
+   std::cout << "=======================================================" << std::endl;
+   for ( auto & cb : cacheBytes )
+   {
+      Long64_t total = cb.second + noCacheBytes[cb.first];
+      float hitRate = total > 0 ? float(cb.second)/total : 0.;
+      std::cout << cb.first << ": hit rate = " << hitRate << ", bytes read = " << total << std::endl;
+   }
+   std::cout << "Total bytes read = " << bytesRead << " in " << readCalls << " read calls" << std::endl;
+   std::cout << "=======================================================" << std::endl;
+   std::cout << std::endl;
+}
@@ -0,0 +1,85 @@
+/**\class GenParticleIndex GenParticleIndex.cc Analysis/Core/src/GenParticleIndex.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Mon, 19 Oct 2026 00:04:50 GMT
+//
+//
+
+// system include files
+#include <cstdlib>
+#include <numeric>
+#include <algorithm>
+//
+// user include files
+#include "Analysis/Core/interface/GenParticleIndex.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+GenParticleIndex::GenParticleIndex() : data_(nullptr)
+{
+}
+
+GenParticleIndex::GenParticleIndex(const ObjectView<GenParticle> & particles) : data_(particles.begin())
+{
+   size_t n = particles.size();
+   std::vector<int> pdg(n), status(n);
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      pdg[i]    = std::abs(particles[i].pdgId());
+      status[i] = particles[i].status();
+      if ( particles[i].higgsDaughter() ) higgsDaughters_.push_back(&particles[i]);
+   }
+   order_.resize(n);
+   std::iota(order_.begin(), order_.end(), 0);
+   std::sort(order_.begin(), order_.end(),
+             [&pdg,&status](const unsigned int & i, const unsigned int & j)
+             {
+                if ( pdg[i] != pdg[j] ) return pdg[i] < pdg[j];
+                if ( status[i] != status[j] ) return status[i] < status[j];
+                return i < j;
+             });
+   pdg_.resize(n);
+   status_.resize(n);
+   for ( size_t k = 0 ; k < n ; ++k )
+   {
+      pdg_[k]    = pdg[order_[k]];
+      status_[k] = status[order_[k]];
+   }
+}
+
+GenParticleIndex::~GenParticleIndex()
+{
+}
+
+//
+// member functions
+//
+GenParticleIndex::Range GenParticleIndex::withPdg(const int & pdg) const
+{
+   auto range = std::equal_range(pdg_.begin(), pdg_.end(), std::abs(pdg));
+   return Range(this, range.first - pdg_.begin(), range.second - pdg_.begin());
+}
+
+GenParticleIndex::Range GenParticleIndex::Range::status(const int & smin, const int & smax) const
+{
+   // the statuses are sorted within the particles of a |pdgId|
+   auto first = index_ -> status_.begin() + first_;
+   auto last  = index_ -> status_.begin() + last_;
+   auto lower = std::lower_bound(first, last, smin);
+   auto upper = smax < smin ? lower : std::upper_bound(lower, last, smax);
+   return Range(index_, lower - index_ -> status_.begin(), upper - index_ -> status_.begin());
+}
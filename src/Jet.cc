@@ -12,6 +12,9 @@
 //
 
 // system include files
+#include <cmath>
+#include <vector>
+#include <algorithm>
 // 
 // user include files
 #include "FWCore/Framework/interface/Event.h"
@@ -60,13 +63,18 @@ bool  Jet::idLoose()                               const { return idloose_;
 bool  Jet::idTight()                               const { return idtight_;                }         
 float Jet::jecUncert()                             const { return jecUnc_;                 }                   
 std::vector<int> Jet::flavours()                   const { return flavours_;               }
-std::vector< std::shared_ptr<GenParticle> >\
+std::vector<const GenParticle *>\
       Jet::partons()                               const { return partons_;        }
 std::string Jet::extendedFlavour()                 const { return extendedFlavour_; }
 float Jet::JerResolution()                         const { return jerResolution_;}
 float Jet::JerSf()                                 const { return jerSF_; }
 float Jet::JerSfDown()                             const { return jerSFDown_; }
 float Jet::JerSfUp()                               const { return jerSFUp_; }
+float Jet::JerSfVariation(const double & n_sigma)  const
+{
+   if ( n_sigma >= 0 ) return n_sigma * (jerSFUp_ - jerSF_) + jerSF_;
+   return std::abs(n_sigma) * (jerSFDown_ - jerSF_) + jerSF_;
+}
 
 float Jet::neutralHadronFraction()                 const { return nHadFrac_; }
 float Jet::neutralEmFraction()                     const { return nEmFrac_;  }
@@ -87,7 +95,7 @@ void Jet::flavour  (const std::string & definition, const int & flav) { flavour_
 void Jet::idLoose  (const bool  & loos)                               { idloose_ = loos; } 
 void Jet::idTight  (const bool  & tigh)                               { idtight_ = tigh; } 
 void Jet::jecUncert(const float & ju)                                 { jecUnc_  = ju; } 
-void Jet::addParton(const std::shared_ptr<GenParticle> & parton)      { partons_.push_back(parton);
+void Jet::addParton(const GenParticle * parton)                       { partons_.push_back(parton);
                                                                         flavours_.push_back(parton->pdgId());  }
 void Jet::btagAlgo (const std::string & algo )                        { btagAlgo_ = algo; }                                                                        
 void Jet::JerResolution(const float & jerResolution)                  { jerResolution_ = jerResolution; }
@@ -129,43 +137,69 @@ int Jet::removeParton(const int & i)
 }
 
 // ------------ methods  ------------
-void Jet::associatePartons(const std::vector< std::shared_ptr<GenParticle> > & particles, const float & dRmax, const float & ptMin,  const bool & pythia8 )
+void Jet::associatePartons(const ObjectView<GenParticle> & particles, const float & dRmax, const float & ptMin,  const bool & pythia8 )
 {
    int flavour = abs(this->flavour());
-   extendedFlavour_ = "udsg";
-   if ( flavour == 5 ) extendedFlavour_ = "b";
-   if ( flavour == 4 ) extendedFlavour_ = "c";
-   
    int flavCounter = 0;
    for ( auto & particle : particles )
+      this -> addParton_(particle, dRmax, ptMin, pythia8, flavour, flavCounter);
+   
+   // Need to check for ambiguities!!!
+   
+   this -> setExtendedFlavour_(flavour, flavCounter);
+}
+
+void Jet::associatePartons(const GenParticleIndex & index, const float & dRmax, const float & ptMin,  const bool & pythia8 )
+{
+   int flavour = abs(this->flavour());
+   // the |pdgId| <= 5 and gluons of the status of the generator, in the order of the collection as above
+   static const int pdgs[] = { 0, 1, 2, 3, 4, 5, 21 };
+   std::vector<unsigned int> candidates;
+   for ( auto & pdg : pdgs )
    {
-      int pdg = particle->pdgId();
-      int status = particle->status();
-      float pt = particle->pt();
-      if ( pt < ptMin ) continue;
-      if ( pythia8 )
-      {
-         if ( status != 71 && status != 72 ) continue;
-      }
-      else
-      {
-         if ( status != 3 ) continue;
-      }
-      if ( abs(pdg) > 5 && pdg != 21 ) continue;
-      if ( this->p4().DeltaR(particle->p4()) > dRmax ) continue;
-      
-      addParton (particle);
-      
-      if ( abs(pdg) == flavour ) ++flavCounter;
-      
+      GenParticleIndex::Range partons = pythia8 ? index.withPdg(pdg).status(71,72) : index.withPdg(pdg).status(3,3);
+      for ( size_t i = 0 ; i < partons.size() ; ++i )
+         candidates.push_back(partons.index(i));
    }
+   std::sort(candidates.begin(), candidates.end());
    
-   // Need to check for ambiguities!!!
+   int flavCounter = 0;
+   for ( auto & i : candidates )
+      this -> addParton_(index.particle(i), dRmax, ptMin, pythia8, flavour, flavCounter);
+   
+   this -> setExtendedFlavour_(flavour, flavCounter);
+}
+
+void Jet::addParton_(const GenParticle & particle, const float & dRmax, const float & ptMin, const bool & pythia8, const int & flavour, int & flavCounter)
+{
+   int pdg = particle.pdgId();
+   int status = particle.status();
+   float pt = particle.pt();
+   if ( pt < ptMin ) return;
+   if ( pythia8 )
+   {
+      if ( status != 71 && status != 72 ) return;
+   }
+   else
+   {
+      if ( status != 3 ) return;
+   }
+   if ( abs(pdg) > 5 && pdg != 21 ) return;
+   if ( this->deltaR(particle) > dRmax ) return;
    
+   addParton (&particle);
+   
+   if ( abs(pdg) == flavour ) ++flavCounter;
+}
+
+void Jet::setExtendedFlavour_(const int & flavour, const int & flavCounter)
+{
+   extendedFlavour_ = "udsg";
+   if ( flavour == 5 ) extendedFlavour_ = "b";
+   if ( flavour == 4 ) extendedFlavour_ = "c";
    // extendedFlavour re-definition
    if ( flavour == 4 && flavCounter > 1 ) extendedFlavour_ = "cc"; 
    if ( flavour == 5 && flavCounter > 1 ) extendedFlavour_ = "bb";
-   
 }
                                                                         
                                                                         
@@ -0,0 +1,172 @@
+/**\class JetVariations JetVariations.cc Analysis/Core/src/JetVariations.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:58:11 GMT
+//
+//
+
+// system include files
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+//
+// user include files
+#include "Analysis/Core/interface/JetVariations.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+JetVariations::JetVariations() : gaus_(false)
+{
+   this -> add("nominal", JER, 0);
+}
+
+JetVariations::JetVariations(const CollectionView<Jet> & jets, const RandomStream & random, const std::string & genJets) :
+   jets_(jets), random_(random), genJets_(genJets), gaus_(false)
+{
+   this -> add("nominal", JER, 0);
+}
+
+JetVariations::~JetVariations()
+{
+}
+
+//
+// member functions
+//
+size_t JetVariations::add(const std::string & name, const Type & type, const double & n_sigma)
+{
+   int v = this -> find(name);
+   if ( v >= 0 )
+   {
+      std::cout << "JetVariations: variation " << name << " already exists" << std::endl;
+      return v;
+   }
+   Variation var;
+   var.name = name;
+   var.type = type;
+   var.nSigma = n_sigma;
+   var.computed = false;
+   variations_.push_back(var);
+   return variations_.size()-1;
+}
+
+void JetVariations::addJerJec()
+{
+   this -> add("jerUp",   JER, +1);
+   this -> add("jerDown", JER, -1);
+   this -> add("jecUp",   JEC, +1);
+   this -> add("jecDown", JEC, -1);
+}
+
+int JetVariations::find(const std::string & name) const
+{
+   for ( size_t v = 0 ; v < variations_.size() ; ++v )
+      if ( variations_[v].name == name ) return v;
+   return -1;
+}
+
+void JetVariations::compute_(const Variation & var) const
+{
+   size_t n = jets_.size();
+   var.pt.resize(n);
+   var.e.resize(n);
+   if ( ! gaus_ )
+   {
+      // by the index of the jet in the collection, as smearTo
+      gausPt_.resize(n);
+      gausE_.resize(n);
+      for ( size_t i = 0 ; i < n ; ++i )
+      {
+         gausPt_[i] = random_.gaus(jets_.index(i), 0);
+         gausE_[i]  = random_.gaus(jets_.index(i), 1);
+      }
+      gaus_ = true;
+   }
+   // the JEC variations are scaled from the nominal JER smearing
+   const double jerSigma = var.type == JER ? var.nSigma : 0;
+   const double jecSigma = var.type == JEC ? var.nSigma : 0;
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      const Jet & jet = jets_[i];
+      double pt = jet.pt();
+      double e  = jet.e();
+      // as Collection<Jet>::smearTo
+      double sf = jet.JerSfVariation(jerSigma);
+      const Candidate * gen = genJets_.empty() ? nullptr : jet.matched(genJets_);
+      if ( gen )
+      {
+         pt = std::max(0., gen -> pt() + sf * (pt - gen -> pt()));
+         e  = std::max(0., gen -> e()  + sf * (e  - gen -> e()));
+      }
+      else if ( sf > 1 )
+      {
+         double sigma = std::sqrt(sf*sf-1)*jet.JerResolution()*jet.pt();
+         pt += sigma * gausPt_[i];
+         e  += sigma * gausE_[i];
+      }
+      if ( jecSigma != 0 )
+      {
+         double scale = 1. + jecSigma * jet.jecUncert();
+         pt *= scale;
+         e  *= scale;
+      }
+      var.pt[i] = pt;
+      var.e[i]  = e;
+   }
+   var.order.resize(n);
+   std::iota(var.order.begin(), var.order.end(), 0);
+   const float * pts = var.pt.data();
+   std::stable_sort(var.order.begin(), var.order.end(),
+                    [pts](const unsigned int & i, const unsigned int & j) { return pts[i] > pts[j]; });
+   var.computed = true;
+}
+
+TLorentzVector JetVariations::p4(const size_t & v, const size_t & i) const
+{
+   TLorentzVector p4;
+   p4.SetPtEtaPhiE(this -> pt(v,i), jets_[i].eta(), jets_[i].phi(), this -> e(v,i));
+   return p4;
+}
+
+float JetVariations::m(const size_t & v, const size_t & i, const size_t & j) const
+{
+   const Jet & j1 = jets_[i];
+   const Jet & j2 = jets_[j];
+   double pt1 = this -> pt(v,i);
+   double pt2 = this -> pt(v,j);
+   double px = pt1*std::cos(j1.phi())  + pt2*std::cos(j2.phi());
+   double py = pt1*std::sin(j1.phi())  + pt2*std::sin(j2.phi());
+   double pz = pt1*std::sinh(j1.eta()) + pt2*std::sinh(j2.eta());
+   double e  = this -> e(v,i) + this -> e(v,j);
+   double m2 = e*e - px*px - py*py - pz*pz;
+   return m2 > 0 ? std::sqrt(m2) : 0;
+}
+
+CollectionView<Jet> JetVariations::leading(const size_t & v, const int & k) const
+{
+   const std::vector<unsigned int> & order = this -> ptOrder(v);
+   size_t n = k < 0 ? order.size() : std::min(order.size(), (size_t) k);
+   CollectionView<Jet> view(jets_);
+   return view.select(std::vector<unsigned int>(order.begin(), order.begin()+n));
+}
+
+size_t JetVariations::countPtMin(const size_t & v, const float & ptmin) const
+{
+   const std::vector<float> & pts = this -> pts(v);
+   return std::count_if(pts.begin(), pts.end(), [&ptmin](const float & pt) { return pt >= ptmin; });
+}
@@ -31,10 +31,10 @@ using namespace analysis::tools;
 //
 // constructors and destructor
 //
-MET::MET() : Candidate() 
+MET::MET() : Candidate(), sig_{0,0,0,0}
 {
 }
-MET::MET(const float & px, const float & py, const float & pz) : Candidate(px,py,pz) 
+MET::MET(const float & px, const float & py, const float & pz) : Candidate(px,py,pz), sig_{0,0,0,0}
 {
 }
 MET::~MET()
@@ -49,11 +49,6 @@ MET::~MET()
 //
 
 // ------------ methods  ------------
-matrix<float> MET::significanceMatrix()
-{
-   return sig_;
-}
-
 float * MET::genP()
 {
    return gen_p_;
@@ -61,11 +56,10 @@ float * MET::genP()
 
 void MET::significanceMatrix (const float & xx, const float & xy, const float & yx, const float & yy)
 {
-   sig_.resize(2,2);
-   sig_(0,0) = xx;
-   sig_(0,1) = xy;
-   sig_(1,0) = yx;
-   sig_(1,1) = yy;
+   sig_.xx = xx;
+   sig_.xy = xy;
+   sig_.yx = yx;
+   sig_.yy = yy;
 }
 
 void MET::genP (const float & px, const float & py, const float & pz)
@@ -74,3 +68,16 @@ void MET::genP (const float & px, const float & py, const float & pz)
    gen_p_[1] = py;
    gen_p_[2] = pz;
 }   
+
+void analysis::tools::metSignificance(const float * px, const float * py,
+                                      const float * xx, const float * xy, const float * yx, const float * yy,
+                                      const size_t & n, float * out)
+{
+   // m^T C^-1 m with the closed form inverse of the 2x2 covariance
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      float det = xx[i]*yy[i] - xy[i]*yx[i];
+      float q = yy[i]*px[i]*px[i] - (xy[i]+yx[i])*px[i]*py[i] + xx[i]*py[i]*py[i];
+      out[i] = det != 0 ? q/det : 0;
+   }
+}
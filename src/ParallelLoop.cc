@@ -0,0 +1,92 @@
+/**\class ParallelLoop ParallelLoop.cc Analysis/Core/src/ParallelLoop.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:15:30 GMT
+//
+//
+
+// system include files
+#include <iostream>
+#include <thread>
+//
+// user include files
+#include "TROOT.h"
+#include "Analysis/Core/interface/ParallelLoop.h"
+#include "Analysis/Core/interface/ChunkScheduler.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+ParallelLoop::ParallelLoop(Analysis & analysis, const int & workers)
+{
+   ROOT::EnableThreadSafety();
+   first_ = analysis.firstEvent();
+   last_  = analysis.lastEvent();
+   for ( int w = 0 ; w < std::max(workers,1) ; ++w )
+      files_.push_back(std::unique_ptr<FileManager>(new FileManager(*analysis.fileManager())));
+   processed_.assign(files_.size(),0);
+   chunks_.assign(files_.size(),0);
+   stolen_.assign(files_.size(),0);
+}
+
+ParallelLoop::~ParallelLoop()
+{
+}
+
+
+//
+// member functions
+//
+void ParallelLoop::run(const std::function<void(FileManager &, const Long64_t &, const int &)> & process)
+{
+   // all workers share the layout of the files, that of the first one is used
+   ChunkScheduler scheduler(files_[0].get(), first_, last_, this->workers());
+
+   processed_.assign(files_.size(),0);
+   chunks_.assign(files_.size(),0);
+
+   std::vector<std::thread> threads;
+   for ( int w = 0 ; w < this->workers() ; ++w )
+   {
+      threads.push_back(std::thread([this,w,&scheduler,&process]()
+      {
+         FileManager & files = *files_[w];
+         Chunk chunk;
+         while ( scheduler.next(w,chunk) )
+         {
+            // a chunk is within one file
+            for ( Long64_t i = chunk.first ; i < chunk.second ; ++i )
+               process(files, files.entry(i), w);
+            processed_[w] += (int) (chunk.second - chunk.first);
+            ++chunks_[w];
+         }
+      }));
+   }
+   for ( auto & t : threads ) t.join();
+
+   for ( int w = 0 ; w < this->workers() ; ++w )
+      stolen_[w] = scheduler.stolen(w);
+}
+
+void ParallelLoop::listWorkers()
+{
+   std::cout << "=======================================================" << std::endl;
+   std::cout << "  WORKERS" << std::endl;
+   std::cout << "=======================================================" << std::endl;
+   for ( int w = 0 ; w < this->workers() ; ++w )
+   {
+      std::cout << "Worker " << w << ": " << processed_[w] << " events in " << chunks_[w] << " chunks, "
+                << stolen_[w] << " of them stolen" << std::endl;
+   }
+   std::cout << "=======================================================" << std::endl;
+   std::cout << std::endl;
+}
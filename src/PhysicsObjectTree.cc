@@ -13,6 +13,8 @@
 
 // system include files
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 //
 // user include files
 #include "Analysis/Core/interface/PhysicsObjectTree.h"
@@ -31,7 +33,7 @@ using namespace analysis::tools;
 template <class Object>
       PhysicsObjectTree<Object>::PhysicsObjectTree() : PhysicsObjectTreeBase<Object>()     {}
 template <class Object>
-      PhysicsObjectTree<Object>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<Object>(tree, name) {}
+      PhysicsObjectTree<Object>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<Object>(tree, name) {}
 template <class Object>
       PhysicsObjectTree<Object>::~PhysicsObjectTree()                                                   {}
 
@@ -48,7 +50,7 @@ template <class Object> Collection<Object>  PhysicsObjectTree<Object>::collectio
 PhysicsObjectTree<Candidate>::PhysicsObjectTree() : PhysicsObjectTreeBase<Candidate>()
 {
 }
-PhysicsObjectTree<Candidate>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<Candidate>(tree, name)
+PhysicsObjectTree<Candidate>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<Candidate>(tree, name)
 {
 }
 PhysicsObjectTree<Candidate>::~PhysicsObjectTree() {}
@@ -56,13 +58,13 @@ PhysicsObjectTree<Candidate>::~PhysicsObjectTree() {}
 // Member functions
 Collection<Candidate>  PhysicsObjectTree<Candidate>::collection()
 {
-   std::vector<Candidate> candidates;
+   std::vector<Candidate> candidates = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       Candidate cand(pt_[i], eta_[i], phi_[i], e_[i], q_[i]);
-      candidates.push_back(cand);
+      candidates.push_back(std::move(cand));
    }
-   Collection<Candidate> CandidateCollection(candidates, name_);
+   Collection<Candidate> CandidateCollection(std::move(candidates), name_);
    return CandidateCollection;
 
 }
@@ -70,10 +72,10 @@ Collection<Candidate>  PhysicsObjectTree<Candidate>::collection()
 
 // JETS
 // Constructors and destructor
-PhysicsObjectTree<Jet>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<Jet>(tree, name)
+PhysicsObjectTree<Jet>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<Jet>(tree, name)
 {
    isSimpleJet_ = false;
-//   tree_  -> SetBranchAddress( "btag_csvivf", btag_    );
+//   this -> branch( "btag_csvivf", btag_    );
    int algos = 0;
    for ( auto & branch : branches_ )
    {
@@ -82,7 +84,7 @@ PhysicsObjectTree<Jet>::PhysicsObjectTree(TChain * tree, const std::string & nam
       {
          mbtag_[branch] = btags_[algos];
          ++algos;
-         tree_  -> SetBranchAddress( branch.c_str(), mbtag_[branch]);
+         this -> branch( branch.c_str(), mbtag_[branch]);
       }
    }
 //    std::vector<std::string>::iterator it;
@@ -92,22 +94,22 @@ PhysicsObjectTree<Jet>::PhysicsObjectTree(TChain * tree, const std::string & nam
    
    if ( mbtag_.size() > 0 )
    {
-      tree_  -> SetBranchAddress( "flavour"        , flavour_ );
-      tree_  -> SetBranchAddress( "hadronFlavour"  , hadrflavour_ );
-      tree_  -> SetBranchAddress( "partonFlavour"  , partflavour_ );
-      tree_  -> SetBranchAddress( "physicsFlavour" , physflavour_ );
-      tree_  -> SetBranchAddress( "id_nHadFrac", nHadFrac_);
-      tree_  -> SetBranchAddress( "id_nEmFrac" , nEmFrac_ );
-      tree_  -> SetBranchAddress( "id_nMult"   , nMult_   );
-      tree_  -> SetBranchAddress( "id_cHadFrac", cHadFrac_);
-      tree_  -> SetBranchAddress( "id_cEmFrac" , cEmFrac_ );
-      tree_  -> SetBranchAddress( "id_cMult"   , cMult_   );
-      tree_  -> SetBranchAddress( "id_muonFrac", muFrac_  );
-      tree_  -> SetBranchAddress( "jecUncert"  , jecUnc_);
-      tree_  -> SetBranchAddress( "jerSF", jerSF_);
-      tree_  -> SetBranchAddress( "jerSFDown", jerSFDown_);
-      tree_  -> SetBranchAddress( "jerSFUp", jerSFUp_);
-      tree_  -> SetBranchAddress( "jerResolution", jerResolution_);
+      this -> branch( "flavour"        , flavour_ );
+      this -> branch( "hadronFlavour"  , hadrflavour_ );
+      this -> branch( "partonFlavour"  , partflavour_ );
+      this -> branch( "physicsFlavour" , physflavour_ );
+      this -> branch( "id_nHadFrac", nHadFrac_);
+      this -> branch( "id_nEmFrac" , nEmFrac_ );
+      this -> branch( "id_nMult"   , nMult_   );
+      this -> branch( "id_cHadFrac", cHadFrac_);
+      this -> branch( "id_cEmFrac" , cEmFrac_ );
+      this -> branch( "id_cMult"   , cMult_   );
+      this -> branch( "id_muonFrac", muFrac_  );
+      this -> branch( "jecUncert"  , jecUnc_);
+      this -> branch( "jerSF", jerSF_);
+      this -> branch( "jerSFDown", jerSFDown_);
+      this -> branch( "jerSFUp", jerSFUp_);
+      this -> branch( "jerResolution", jerResolution_);
    }
    else
    {
@@ -115,7 +117,7 @@ PhysicsObjectTree<Jet>::PhysicsObjectTree(TChain * tree, const std::string & nam
    }
 //   std::cout << "oioi" << std::endl;
 //   std::vector<std::string>::iterator it;
-//   it = std::find(branches_.begin(),branches_.end(),"jecUncert");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str(), jecUnc_);
+//   it = std::find(branches_.begin(),branches_.end(),"jecUncert");  if ( it != branches_.end() ) this -> branch( (*it).c_str(), jecUnc_);
 
 }
 PhysicsObjectTree<Jet>::~PhysicsObjectTree() {}
@@ -123,7 +125,7 @@ PhysicsObjectTree<Jet>::~PhysicsObjectTree() {}
 // Member functions
 Collection<Jet>  PhysicsObjectTree<Jet>::collection()
 {
-   std::vector<Jet> jets;
+   std::vector<Jet> jets = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       Jet jet(pt_[i], eta_[i], phi_[i], e_[i]);
@@ -146,79 +148,86 @@ Collection<Jet>  PhysicsObjectTree<Jet>::collection()
       jet.JerSf(jerSF_[i]);
       jet.JerSfUp(jerSFUp_[i]);
       jet.JerSfDown(jerSFDown_[i]);
-      jets.push_back(jet);
+      jets.push_back(std::move(jet));
    }
-   Collection<Jet> jetCollection(jets, name_);
+   Collection<Jet> jetCollection(std::move(jets), name_);
    return jetCollection;
 
 }
 
 // GENPARTICLE
 // Constructors and destructor
-PhysicsObjectTree<GenParticle>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<GenParticle>(tree, name)
+PhysicsObjectTree<GenParticle>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<GenParticle>(tree, name)
 {
-   tree_  -> SetBranchAddress( "pdg"   , pdgid_  );
-   tree_  -> SetBranchAddress( "status", status_ );
-   tree_  -> SetBranchAddress( "higgs_dau", higgs_dau_ );
+   this -> branch( "pdg"   , pdgid_  );
+   this -> branch( "status", status_ );
+   this -> branch( "higgs_dau", higgs_dau_ );
 }
 PhysicsObjectTree<GenParticle>::~PhysicsObjectTree() {}
 
 // Member functions
 Collection<GenParticle>  PhysicsObjectTree<GenParticle>::collection()
 {
-   std::vector<GenParticle> particles;
+   std::vector<GenParticle> particles = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       GenParticle p(pt_[i], eta_[i], phi_[i], e_[i], q_[i]);
       p.pdgId(pdgid_[i]);
       p.status(status_[i]);
       p.higgsDaughter(higgs_dau_[i]);
-      particles.push_back(p);
+      particles.push_back(std::move(p));
    }
-   Collection<GenParticle> genPartCollection(particles, name_);
+   Collection<GenParticle> genPartCollection(std::move(particles), name_);
    return genPartCollection;
 
 }
 
 // MET
 // Constructors and destructor
-PhysicsObjectTree<MET>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<MET>(tree, name)
+PhysicsObjectTree<MET>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<MET>(tree, name)
 {
-   tree_  -> SetBranchAddress( "sigxx" , sigxx_ );
-   tree_  -> SetBranchAddress( "sigxy" , sigxy_ );
-   tree_  -> SetBranchAddress( "sigyx" , sigyx_ );
-   tree_  -> SetBranchAddress( "sigyy" , sigyy_ );
+   this -> branch( "sigxx" , sigxx_ );
+   this -> branch( "sigxy" , sigxy_ );
+   this -> branch( "sigyx" , sigyx_ );
+   this -> branch( "sigyy" , sigyy_ );
    // Exists in MC; check if available and set
    // Maybe it's better to use analysis::isMC() for this perpouse?
    std::vector<std::string>::iterator it;
-   it = std::find(branches_.begin(),branches_.end(),"gen_px");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str(), gen_px_);
-   it = std::find(branches_.begin(),branches_.end(),"gen_py");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str(), gen_py_);
-   it = std::find(branches_.begin(),branches_.end(),"gen_pz");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str(), gen_pz_);
+   it = std::find(branches_.begin(),branches_.end(),"gen_px");  if ( it != branches_.end() ) this -> branch( (*it).c_str(), gen_px_);
+   it = std::find(branches_.begin(),branches_.end(),"gen_py");  if ( it != branches_.end() ) this -> branch( (*it).c_str(), gen_py_);
+   it = std::find(branches_.begin(),branches_.end(),"gen_pz");  if ( it != branches_.end() ) this -> branch( (*it).c_str(), gen_pz_);
 }
 PhysicsObjectTree<MET>::~PhysicsObjectTree() {}
 
 // Member function
 Collection<MET>  PhysicsObjectTree<MET>::collection()
 {
-   std::vector<MET> mets;
+   std::vector<MET> mets = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       MET met(px_[i], py_[i], pz_[i]);
       met.significanceMatrix(sigxx_[i],sigxy_[i],sigyx_[i],sigyy_[i]);
       met.genP(gen_px_[i],gen_py_[i],gen_pz_[i]);
-      mets.push_back(met);
+      mets.push_back(std::move(met));
    }
-   Collection<MET> metCollection(mets, name_);
+   Collection<MET> metCollection(std::move(mets), name_);
    return metCollection;
 
 }
 
+std::vector<float> PhysicsObjectTree<MET>::significances() const
+{
+   std::vector<float> sig(n_);
+   metSignificance(px_, py_, sigxx_, sigxy_, sigyx_, sigyy_, n_, sig.data());
+   return sig;
+}
+
 // MUON
 // Constructors and destructor
 PhysicsObjectTree<Muon>::PhysicsObjectTree() : PhysicsObjectTreeBase<Muon>()
 {
 }
-PhysicsObjectTree<Muon>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<Muon>(tree, name)
+PhysicsObjectTree<Muon>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<Muon>(tree, name)
 {
 }
 PhysicsObjectTree<Muon>::~PhysicsObjectTree()
@@ -227,13 +236,13 @@ PhysicsObjectTree<Muon>::~PhysicsObjectTree()
 // Member functions
 Collection<Muon>  PhysicsObjectTree<Muon>::collection()
 {
-   std::vector<Muon> muons;
+   std::vector<Muon> muons = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       Muon muon(pt_[i], eta_[i], phi_[i], e_[i], q_[i]);
-      muons.push_back(muon);
+      muons.push_back(std::move(muon));
    }
-   Collection<Muon> muonCollection(muons, name_);
+   Collection<Muon> muonCollection(std::move(muons), name_);
    return muonCollection;
 }
 
@@ -242,9 +251,9 @@ Collection<Muon>  PhysicsObjectTree<Muon>::collection()
 PhysicsObjectTree<JetTag>::PhysicsObjectTree() : PhysicsObjectTreeBase<JetTag>()
 {
 }
-PhysicsObjectTree<JetTag>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<JetTag>(tree, name)
+PhysicsObjectTree<JetTag>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<JetTag>(tree, name)
 {
-   tree_  -> SetBranchAddress( "btag", btag_    );
+   this -> branch( "btag", btag_    );
 }
 PhysicsObjectTree<JetTag>::~PhysicsObjectTree()
 {
@@ -252,14 +261,14 @@ PhysicsObjectTree<JetTag>::~PhysicsObjectTree()
 // Member functions
 Collection<JetTag>  PhysicsObjectTree<JetTag>::collection()
 {
-   std::vector<JetTag> jetstags;
+   std::vector<JetTag> jetstags = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       JetTag jettag(pt_[i], eta_[i], phi_[i], e_[i]);
       jettag.btag(btag_[i]);
-      jetstags.push_back(jettag);
+      jetstags.push_back(std::move(jettag));
    }
-   Collection<JetTag> jettagCollection(jetstags, name_);
+   Collection<JetTag> jettagCollection(std::move(jetstags), name_);
    return jettagCollection;
 }
 
@@ -269,7 +278,7 @@ Collection<JetTag>  PhysicsObjectTree<JetTag>::collection()
 PhysicsObjectTree<GenJet>::PhysicsObjectTree() : PhysicsObjectTreeBase<GenJet>()
 {
 }
-PhysicsObjectTree<GenJet>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<GenJet>(tree, name)
+PhysicsObjectTree<GenJet>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<GenJet>(tree, name)
 {
 }
 PhysicsObjectTree<GenJet>::~PhysicsObjectTree()
@@ -278,13 +287,13 @@ PhysicsObjectTree<GenJet>::~PhysicsObjectTree()
 // Member functions
 Collection<GenJet>  PhysicsObjectTree<GenJet>::collection()
 {
-   std::vector<GenJet> genjets;
+   std::vector<GenJet> genjets = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       GenJet genjet(pt_[i], eta_[i], phi_[i], e_[i], q_[i]);
-      genjets.push_back(genjet);
+      genjets.push_back(std::move(genjet));
    }
-   Collection<GenJet> genjetCollection(genjets, name_);
+   Collection<GenJet> genjetCollection(std::move(genjets), name_);
    return genjetCollection;
 }
 
@@ -293,13 +302,13 @@ Collection<GenJet>  PhysicsObjectTree<GenJet>::collection()
 // VERTEX
 // Constructors and destructor
 PhysicsObjectTree<Vertex>::PhysicsObjectTree()              : PhysicsObjectTreeBase<Vertex>()     {}
-PhysicsObjectTree<Vertex>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<Vertex>(tree, name) {}
+PhysicsObjectTree<Vertex>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<Vertex>(tree, name) {}
 PhysicsObjectTree<Vertex>::~PhysicsObjectTree()                                                   {}
 
 // Member functions
 Collection<Vertex>  PhysicsObjectTree<Vertex>::collection()
 {
-   std::vector<Vertex> vertices;
+   std::vector<Vertex> vertices = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       Vertex vertex(x_[i], y_[i], z_[i]);
@@ -308,18 +317,50 @@ Collection<Vertex>  PhysicsObjectTree<Vertex>::collection()
       vertex.rho(rho_[i]);
       vertex.fake(fake_[i]);
 
-      vertices.push_back(vertex);
+      vertices.push_back(std::move(vertex));
    }
-   Collection<Vertex> vertexCollection(vertices, name_ );
+   Collection<Vertex> vertexCollection(std::move(vertices), name_);
    return vertexCollection;
 }
 
+VertexSummary PhysicsObjectTree<Vertex>::summary() const
+{
+   VertexSummary summary;
+   summary.n = n_;
+   if ( n_ <= 0 ) return summary;
+   const float pvz = z_[0];
+   // the good flags as numbers, so that the loop has no branches
+   int   ngood = 0;
+   int   nnear = 0;
+   float sumz  = 0;
+   float sumz2 = 0;
+   for ( int i = 0 ; i < n_ ; ++i )
+   {
+      int good = (! fake_[i]) & (ndof_[i] > 4) & (std::fabs(z_[i]) <= 24) & (rho_[i] <= 2);
+      ngood += good;
+      nnear += good & (std::fabs(z_[i] - pvz) < 1);
+      sumz  += good * z_[i];
+      sumz2 += good * z_[i]*z_[i];
+   }
+   summary.nGood  = ngood;
+   summary.pvZ    = pvz;
+   summary.pvGood = (! fake_[0]) && ndof_[0] > 4 && std::fabs(pvz) <= 24 && rho_[0] <= 2;
+   if ( ngood > 0 )
+   {
+      summary.zMean = sumz/ngood;
+      summary.zRms  = std::sqrt(std::max(0.f, sumz2/ngood - summary.zMean*summary.zMean));
+   }
+   // the other good vertices, the primary vertex itself is within 1 cm of its z
+   summary.pvDensity = (nnear - (int) summary.pvGood)/2.;
+   return summary;
+}
+
 // TriggerObjects
 // Constructors and destructor
 PhysicsObjectTree<TriggerObject>::PhysicsObjectTree() : PhysicsObjectTreeBase<TriggerObject>()
 {
 }
-PhysicsObjectTree<TriggerObject>::PhysicsObjectTree(TChain * tree, const std::string & name) : PhysicsObjectTreeBase<TriggerObject>(tree, name)
+PhysicsObjectTree<TriggerObject>::PhysicsObjectTree(TTree * tree, const std::string & name) : PhysicsObjectTreeBase<TriggerObject>(tree, name)
 {
 }
 PhysicsObjectTree<TriggerObject>::~PhysicsObjectTree() {}
@@ -327,13 +368,13 @@ PhysicsObjectTree<TriggerObject>::~PhysicsObjectTree() {}
 // Member functions
 Collection<TriggerObject>  PhysicsObjectTree<TriggerObject>::collection()
 {
-   std::vector<TriggerObject> triggers;
+   std::vector<TriggerObject> triggers = this -> storage_();
    for ( int i = 0 ; i < n_ ; ++i )
    {
       TriggerObject trig(pt_[i], eta_[i], phi_[i], e_[i]);
-      triggers.push_back(trig);
+      triggers.push_back(std::move(trig));
    }
-   Collection<TriggerObject> TriggerObjectCollection(triggers, name_);
+   Collection<TriggerObject> TriggerObjectCollection(std::move(triggers), name_);
    return TriggerObjectCollection;
 
 }
@@ -33,18 +33,18 @@ PhysicsObjectTreeBase<Object>::PhysicsObjectTreeBase() : TreeBase()
 {
 }
 template <class Object>
-PhysicsObjectTreeBase<Object>::PhysicsObjectTreeBase(TChain * tree, const std::string & name) : TreeBase(tree, name)
+PhysicsObjectTreeBase<Object>::PhysicsObjectTreeBase(TTree * tree, const std::string & name) : TreeBase(tree, name)
 {
-   tree_  -> SetBranchAddress( "n"  , &n_   );
-   tree_  -> SetBranchAddress( "pt" ,  pt_  );
-   tree_  -> SetBranchAddress( "eta",  eta_ );
-   tree_  -> SetBranchAddress( "phi",  phi_ );
-   tree_  -> SetBranchAddress( "e"  ,  e_   );
+   this -> branch( "n"  , &n_   );
+   this -> branch( "pt" ,  pt_  );
+   this -> branch( "eta",  eta_ );
+   this -> branch( "phi",  phi_ );
+   this -> branch( "e"  ,  e_   );
    std::vector<std::string>::iterator it;
-   it = std::find(branches_.begin(),branches_.end(),"q") ;  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str() , q_ );
-   it = std::find(branches_.begin(),branches_.end(),"px");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str() , px_  );
-   it = std::find(branches_.begin(),branches_.end(),"py");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str() , py_  );
-   it = std::find(branches_.begin(),branches_.end(),"pz");  if ( it != branches_.end() ) tree_  -> SetBranchAddress( (*it).c_str() , pz_  );
+   it = std::find(branches_.begin(),branches_.end(),"q") ;  if ( it != branches_.end() ) this -> branch( (*it).c_str() , q_ );
+   it = std::find(branches_.begin(),branches_.end(),"px");  if ( it != branches_.end() ) this -> branch( (*it).c_str() , px_  );
+   it = std::find(branches_.begin(),branches_.end(),"py");  if ( it != branches_.end() ) this -> branch( (*it).c_str() , py_  );
+   it = std::find(branches_.begin(),branches_.end(),"pz");  if ( it != branches_.end() ) this -> branch( (*it).c_str() , pz_  );
 
 }
 
@@ -69,19 +69,19 @@ PhysicsObjectTreeBase<Vertex>::PhysicsObjectTreeBase() : TreeBase()
 {
 }
 
-PhysicsObjectTreeBase<Vertex>::PhysicsObjectTreeBase(TChain * tree, const std::string & name) : TreeBase(tree, name)
+PhysicsObjectTreeBase<Vertex>::PhysicsObjectTreeBase(TTree * tree, const std::string & name) : TreeBase(tree, name)
 {
-   tree_  -> SetBranchAddress( "n"   , &n_    );
-   tree_  -> SetBranchAddress( "x"   ,  x_    );
-   tree_  -> SetBranchAddress( "y"   ,  y_    );
-   tree_  -> SetBranchAddress( "z"   ,  z_    );
-   tree_  -> SetBranchAddress( "xe"  ,  xe_   );
-   tree_  -> SetBranchAddress( "ye"  ,  ye_   );
-   tree_  -> SetBranchAddress( "ze"  ,  ze_   );
-   tree_  -> SetBranchAddress( "fake",  fake_ );
-   tree_  -> SetBranchAddress( "chi2",  chi2_ );
-   tree_  -> SetBranchAddress( "ndof",  ndof_ );
-   tree_  -> SetBranchAddress( "rho" ,  rho_  );
+   this -> branch( "n"   , &n_    );
+   this -> branch( "x"   ,  x_    );
+   this -> branch( "y"   ,  y_    );
+   this -> branch( "z"   ,  z_    );
+   this -> branch( "xe"  ,  xe_   );
+   this -> branch( "ye"  ,  ye_   );
+   this -> branch( "ze"  ,  ze_   );
+   this -> branch( "fake",  fake_ );
+   this -> branch( "chi2",  chi2_ );
+   this -> branch( "ndof",  ndof_ );
+   this -> branch( "rho" ,  rho_  );
 }
 
 PhysicsObjectTreeBase<Vertex>::~PhysicsObjectTreeBase()
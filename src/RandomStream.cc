@@ -0,0 +1,150 @@
+/**\class RandomStream RandomStream.cc Analysis/Core/src/RandomStream.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Sun, 18 Oct 2026 23:53:27 GMT
+//
+//
+
+// system include files
+#include <cmath>
+//
+// user include files
+#include "Analysis/Core/interface/RandomStream.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+RandomStream::RandomStream()
+{
+   key_[0] = 0;
+   key_[1] = 0;
+   event_      = 0;
+   collection_ = 0;
+   variation_  = 0;
+}
+
+RandomStream::RandomStream(const int & run, const int & lumi, const int & event, const std::string & collection, const int & variation)
+{
+   key_[0] = (uint32_t) run;
+   key_[1] = (uint32_t) lumi;
+   event_      = (uint32_t) event;
+   collection_ = hash(collection);
+   variation_  = (uint32_t) variation;
+}
+
+RandomStream::~RandomStream()
+{
+}
+
+//
+// member functions
+//
+uint32_t RandomStream::hash(const std::string & name)
+{
+   uint32_t h = 2166136261u;
+   for ( auto & c : name )
+   {
+      h ^= (unsigned char) c;
+      h *= 16777619u;
+   }
+   return h;
+}
+
+void RandomStream::philox(uint32_t ctr[4], const uint32_t key[2])
+{
+   const uint32_t m0 = 0xD2511F53, m1 = 0xCD9E8D57;
+   const uint32_t w0 = 0x9E3779B9, w1 = 0xBB67AE85;
+   uint32_t k0 = key[0], k1 = key[1];
+   for ( int round = 0 ; round < 10 ; ++round )
+   {
+      uint64_t p0 = (uint64_t) m0 * ctr[0];
+      uint64_t p1 = (uint64_t) m1 * ctr[2];
+      uint32_t c0 = (uint32_t)(p1 >> 32) ^ ctr[1] ^ k0;
+      uint32_t c2 = (uint32_t)(p0 >> 32) ^ ctr[3] ^ k1;
+      ctr[0] = c0;
+      ctr[1] = (uint32_t) p1;
+      ctr[2] = c2;
+      ctr[3] = (uint32_t) p0;
+      k0 += w0;
+      k1 += w1;
+   }
+}
+
+double RandomStream::uniform_(const uint32_t & high, const uint32_t & low)
+{
+   // 53 bits, centred in their interval so that neither 0 nor 1 is returned
+   uint64_t bits = ( ((uint64_t) high << 32) | low ) >> 11;
+   return (bits + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+void RandomStream::counter_(const unsigned int & index, const unsigned int & block, uint32_t ctr[4]) const
+{
+   ctr[0] = event_;
+   ctr[1] = collection_;
+   ctr[2] = index;
+   ctr[3] = (variation_ << 16) ^ block;
+}
+
+void RandomStream::words(const unsigned int & index, const unsigned int & block, uint32_t out[4]) const
+{
+   this -> counter_(index, block, out);
+   philox(out, key_);
+}
+
+double RandomStream::uniform(const unsigned int & index, const unsigned int & draw) const
+{
+   uint32_t w[4];
+   this -> words(index, draw/2, w);
+   return draw%2 == 0 ? uniform_(w[0],w[1]) : uniform_(w[2],w[3]);
+}
+
+double RandomStream::gaus(const unsigned int & index, const unsigned int & draw) const
+{
+   // Box-Muller, a block gives the draws 2k and 2k+1
+   uint32_t w[4];
+   this -> words(index, draw/2, w);
+   double r   = std::sqrt(-2.*std::log(uniform_(w[0],w[1])));
+   double phi = 2.*M_PI*uniform_(w[2],w[3]);
+   return draw%2 == 0 ? r*std::cos(phi) : r*std::sin(phi);
+}
+
+double RandomStream::gaus(const unsigned int & index, const double & mean, const double & sigma, const unsigned int & draw) const
+{
+   return mean + sigma * this -> gaus(index, draw);
+}
+
+void RandomStream::gaus(const size_t & n, std::vector<double> & draw0, std::vector<double> & draw1) const
+{
+   // the uniforms of all objects first, then Box-Muller over the columns
+   draw0.resize(n);
+   draw1.resize(n);
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      uint32_t w[4];
+      this -> words(i, 0, w);
+      draw0[i] = uniform_(w[0],w[1]);
+      draw1[i] = uniform_(w[2],w[3]);
+   }
+   double * u = draw0.data();
+   double * v = draw1.data();
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      double r   = std::sqrt(-2.*std::log(u[i]));
+      double phi = 2.*M_PI*v[i];
+      u[i] = r*std::cos(phi);
+      v[i] = r*std::sin(phi);
+   }
+}
@@ -17,6 +17,7 @@
 #include <algorithm> 
 // 
 // user include files
+#include "TBranch.h"
 #include "Analysis/Core/interface/TreeBase.h"
 
 
@@ -33,12 +34,23 @@ using namespace analysis::tools;
 // template <typename Object>
 TreeBase::TreeBase() : TChain()
 {
+   tree_        = nullptr;
+   bytes_       = 0;
+   zipBytes_    = 0;
 }
 //template <typename Object>
-TreeBase::TreeBase(TChain * tree, const std::string & name) : TChain()
+TreeBase::TreeBase(TTree * tree, const std::string & name) : TChain()
 {
    tree_ = tree;
    name_ = name;
+   bytes_    = 0;
+   zipBytes_ = 0;
+   if ( ! tree_ )
+   {
+      std::cout << "TreeBase: tree of " << name << " does not exist" << std::endl;
+      return;
+   }
+   this -> initBaskets_(tree_ -> GetListOfBranches());
    
    std::string treeTitle = std::string(tree_->GetTitle());
    treeTitle.erase(std::remove(treeTitle.begin(),treeTitle.end(),' '),treeTitle.end());
@@ -61,6 +73,64 @@ TreeBase::~TreeBase()
 // member functions
 //
 
-void TreeBase::event(const int & event) { tree_ -> GetEntry(event); }
-TChain * TreeBase::tree() { return tree_; }
+void TreeBase::event(const int & event)
+{
+   if ( ! tree_ ) return;
+   Int_t n = tree_ -> GetEntry(event);
+   if ( n <= 0 ) return;
+   bytes_ += n;
+   // a branch reads a basket, compressed as it is in the file, when the entry is not in the previous one
+   for ( auto & b : baskets_ )
+   {
+      Int_t basket = b.first -> GetReadBasket();
+      if ( basket == b.second || basket < 0 ) continue;
+      b.second = basket;
+      zipBytes_ += b.first -> GetBasketBytes()[basket];
+   }
+}
+
+void TreeBase::initBaskets_(TObjArray * branches)
+{
+   if ( ! branches ) return;
+   for ( int i = 0 ; i < branches -> GetEntries() ; ++i )
+   {
+      TBranch * b = (TBranch*) branches -> At(i);
+      baskets_.push_back(std::make_pair(b, -1));
+      this -> initBaskets_(b -> GetListOfBranches());
+   }
+}
+
+Long64_t TreeBase::bytes()    { return bytes_; }
+Long64_t TreeBase::zipBytes() { return zipBytes_; }
+TTree * TreeBase::tree() { return tree_; }
+std::vector<std::string> TreeBase::branches() { return branches_; }
+
+std::vector<std::string> TreeBase::branchesRead()
+{
+   std::vector<std::string> branches;
+   for ( auto & address : addresses_ )
+      branches.push_back(address.first);
+   return branches;
+}
+
+void TreeBase::tree(TTree * tree)
+{
+   tree_ = tree;
+   // the branches of the previous tree are deleted with its file
+   baskets_.clear();
+   if ( ! tree_ ) return;
+   this -> initBaskets_(tree_ -> GetListOfBranches());
+   for ( auto & address : addresses_ )
+      tree_ -> SetBranchAddress(address.first.c_str(), address.second);
+}
+
+void TreeBase::branch(const std::string & name, void * address)
+{
+   // a new address of the same branch replaces the previous one
+   auto it = std::find_if(addresses_.begin(),addresses_.end(),
+                          [&name](const std::pair<std::string, void *> & a) { return a.first == name; });
+   if ( it != addresses_.end() ) it -> second = address;
+   else                          addresses_.push_back(std::make_pair(name,address));
+   if ( tree_ ) tree_ -> SetBranchAddress(name.c_str(), address);
+}
 
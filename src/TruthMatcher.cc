@@ -0,0 +1,185 @@
+/**\class TruthMatcher TruthMatcher.cc Analysis/Core/src/TruthMatcher.cc
+
+ Description: [one line class summary]
+
+ Implementation:
+     [Notes on implementation]
+*/
+//
+// Original Author:  agent
+//         Created:  Mon, 19 Oct 2026 00:07:01 GMT
+//
+//
+
+// system include files
+#include <cmath>
+#include <algorithm>
+#include <utility>
+//
+// user include files
+#include "Analysis/Core/interface/TruthMatcher.h"
+
+//
+// class declaration
+//
+
+using namespace analysis;
+using namespace analysis::tools;
+
+//
+// constructors and destructor
+//
+TruthMatcher::TruthMatcher()
+{
+}
+
+TruthMatcher::~TruthMatcher()
+{
+}
+
+//
+// member functions
+//
+void TruthMatcher::add(const CandidateView & objects, const float & dRmax, const float & dPtRelMax)
+{
+   std::vector<const Candidate *> pointers;
+   pointers.reserve(objects.size());
+   for ( auto & object : objects ) pointers.push_back(&object);
+   this -> addLevel_(std::move(pointers), dRmax, dPtRelMax);
+}
+
+void TruthMatcher::addLevel_(std::vector<const Candidate *> && objects, const float & dRmax, const float & dPtRelMax)
+{
+   Level level;
+   level.objects = std::move(objects);
+   size_t n = level.objects.size();
+   level.eta.resize(n);
+   level.phi.resize(n);
+   level.pt.resize(n);
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      level.eta[i] = level.objects[i] -> eta();
+      level.phi[i] = level.objects[i] -> phi();
+      level.pt[i]  = level.objects[i] -> pt();
+   }
+   level.dRmax = dRmax;
+   level.dPtRelMax = dPtRelMax;
+   levels_.push_back(std::move(level));
+   table_.clear();
+   deltaR_.clear();
+}
+
+void TruthMatcher::clear()
+{
+   levels_.clear();
+   table_.clear();
+   deltaR_.clear();
+}
+
+void TruthMatcher::matchLevel_(const Level & from, const std::vector<bool> & active, Level & to)
+{
+   size_t n = to.objects.size();
+   to.previous.assign(n, -1);
+   to.deltaR.assign(n, -1.);
+   if ( n == 0 || to.dRmax <= 0 ) return;
+
+   // eta-phi grid of the objects of the level, cells of size dRmax (at least) in phi
+   const float cell = to.dRmax;
+   const int nphi = std::max(1, (int) std::floor(2*M_PI/cell));
+   const float cellPhi = 2*M_PI/nphi;
+   auto ieta = [cell](const float & eta) { return (long) std::floor(eta/cell); };
+   auto iphi = [cellPhi,nphi](const float & phi) { return std::min(nphi-1, std::max(0, (int) std::floor((phi+M_PI)/cellPhi))); };
+   auto key  = [nphi](const long & ie, const int & ip) { return ie*nphi + ip; };
+   std::vector< std::pair<long,int> > grid(n);
+   for ( size_t j = 0 ; j < n ; ++j )
+      grid[j] = std::make_pair(key(ieta(to.eta[j]), iphi(to.phi[j])), (int) j);
+   std::sort(grid.begin(), grid.end());
+
+   // candidate pairs from the neighbouring cells
+   struct Pair { float dR2; int i; int j; };
+   std::vector<Pair> pairs;
+   const float dR2max = to.dRmax*to.dRmax;
+   for ( size_t i = 0 ; i < from.objects.size() ; ++i )
+   {
+      if ( ! active[i] ) continue;
+      long ie = ieta(from.eta[i]);
+      int  ip = iphi(from.phi[i]);
+      for ( int de = -1 ; de <= 1 ; ++de )
+      {
+         for ( int dp = -1 ; dp <= 1 ; ++dp )
+         {
+            // with less than three cells in phi the neighbours repeat
+            if ( nphi < 3 && dp != 0 && ( nphi == 1 || dp == 1 ) ) continue;
+            int jp = ( ip + dp + nphi ) % nphi;
+            long k = key(ie+de, jp);
+            auto range = std::equal_range(grid.begin(), grid.end(), std::make_pair(k, -1),
+                                          [](const std::pair<long,int> & a, const std::pair<long,int> & b) { return a.first < b.first; });
+            for ( auto it = range.first ; it != range.second ; ++it )
+            {
+               int j = it -> second;
+               float dR2 = deltaR2(from.eta[i], from.phi[i], to.eta[j], to.phi[j]);
+               if ( dR2 > dR2max ) continue;
+               if ( to.dPtRelMax > 0 && std::fabs(to.pt[j] - from.pt[i]) > to.dPtRelMax*from.pt[i] ) continue;
+               pairs.push_back(Pair{dR2, (int) i, j});
+            }
+         }
+      }
+   }
+
+   // the closest pairs first, each object used once
+   std::sort(pairs.begin(), pairs.end(),
+             [](const Pair & a, const Pair & b) { return a.dR2 < b.dR2 || ( a.dR2 == b.dR2 && ( a.i < b.i || ( a.i == b.i && a.j < b.j ) ) ); });
+   std::vector<bool> used(from.objects.size(), false);
+   for ( auto & pair : pairs )
+   {
+      if ( used[pair.i] || to.previous[pair.j] >= 0 ) continue;
+      used[pair.i] = true;
+      to.previous[pair.j] = pair.i;
+      to.deltaR[pair.j] = std::sqrt(pair.dR2);
+   }
+}
+
+void TruthMatcher::match()
+{
+   size_t nlevels = levels_.size();
+   size_t nsources = this -> size();
+   table_.assign(nsources*nlevels, -1);
+   deltaR_.assign(nsources*nlevels, -1.);
+   if ( nlevels == 0 ) return;
+
+   // the objects of a level matched to the previous one are the sources of the next
+   std::vector<bool> active(nsources, true);
+   for ( size_t l = 1 ; l < nlevels ; ++l )
+   {
+      this -> matchLevel_(levels_[l-1], active, levels_[l]);
+      active.assign(levels_[l].objects.size(), false);
+      for ( size_t j = 0 ; j < levels_[l].objects.size() ; ++j )
+         active[j] = levels_[l].previous[j] >= 0;
+   }
+
+   // the chains, from the sources
+   for ( size_t s = 0 ; s < nsources ; ++s )
+      table_[s*nlevels] = s;
+   for ( size_t l = 1 ; l < nlevels ; ++l )
+   {
+      // the object of the level matched to each object of the previous level
+      std::vector<int> next(levels_[l-1].objects.size(), -1);
+      for ( size_t j = 0 ; j < levels_[l].objects.size() ; ++j )
+         if ( levels_[l].previous[j] >= 0 ) next[levels_[l].previous[j]] = j;
+      for ( size_t s = 0 ; s < nsources ; ++s )
+      {
+         int prev = table_[s*nlevels + l-1];
+         if ( prev < 0 ) continue;
+         int j = next[prev];
+         table_[s*nlevels + l] = j;
+         if ( j >= 0 ) deltaR_[s*nlevels + l] = levels_[l].deltaR[j];
+      }
+   }
+}
+
+bool TruthMatcher::complete(const size_t & source) const
+{
+   for ( size_t l = 0 ; l < levels_.size() ; ++l )
+      if ( this -> index(source, l) < 0 ) return false;
+   return true;
+}
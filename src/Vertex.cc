@@ -39,6 +39,10 @@ Vertex::Vertex(const float & x, const float & y, const float & z) : x_(x), y_(y)
 {
 }
 
+VertexSummary::VertexSummary() : n(0), nGood(0), pvZ(-999.), pvGood(false), zMean(0.), zRms(0.), pvDensity(0.)
+{
+}
+
 Vertex::~Vertex()
 {
    // do anything here that needs to be done at desctruction time
@@ -0,0 +1,132 @@
+#ifndef Analysis_Core_TestNtuple_h
+#define Analysis_Core_TestNtuple_h 1
+
+// Small ntuples with a known content for the tests of Analysis/Core.
+//
+// The file has the MssmHbb/Events/EventInfo tree (event = entry+1, run = 1,
+// i.e. MC, lumisection = 1 + entry/100) and a tree of candidates,
+// MssmHbb/Events/candidates, with n = entry%5 candidates of pt = entry+1+i,
+// a tree of vertices, MssmHbb/Events/primaryVertices, with 1 + entry%4
+// vertices at z = 0.5*i, all good but the third, which is fake, and a tree of
+// generated particles, MssmHbb/Events/prunedGenParticles, with 1 + entry%3
+// partons (status 71) of pt = entry+1+i, along the candidates, b quarks and
+// gluons in turn.
+// The file list to be given to Analysis is written next to the file.
+
+#include <string>
+#include <fstream>
+#include <cmath>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TDirectory.h"
+
+inline std::string writeTestNtuple(const std::string & name, const int & nevents, const Long64_t & autoflush = 0)
+{
+   const int MAX = 10;
+   int event, run, lumisection;
+   int n, q[MAX];
+   float pt[MAX], eta[MAX], phi[MAX], e[MAX];
+   int nv;
+   float x[MAX], y[MAX], z[MAX], xe[MAX], ye[MAX], ze[MAX], chi2[MAX], ndof[MAX], rho[MAX];
+   bool fake[MAX];
+   int ng, pdg[MAX], status[MAX], gq[MAX];
+   float gpt[MAX], geta[MAX], gphi[MAX], ge[MAX];
+   bool higgs_dau[MAX];
+
+   TFile * file = new TFile((name + ".root").c_str(), "RECREATE");
+   TDirectory * dir = file -> mkdir("MssmHbb") -> mkdir("Events");
+   dir -> cd();
+   TTree * eventInfo = new TTree("EventInfo", "EventInfo");
+   eventInfo -> Branch("event", &event, "event/I");
+   eventInfo -> Branch("run", &run, "run/I");
+   eventInfo -> Branch("lumisection", &lumisection, "lumisection/I");
+   TTree * candidates = new TTree("candidates", "Candidate|candidates");
+   candidates -> Branch("n", &n, "n/I");
+   candidates -> Branch("pt", pt, "pt[n]/F");
+   candidates -> Branch("eta", eta, "eta[n]/F");
+   candidates -> Branch("phi", phi, "phi[n]/F");
+   candidates -> Branch("e", e, "e[n]/F");
+   candidates -> Branch("q", q, "q[n]/I");
+   TTree * vertices = new TTree("primaryVertices", "reco::Vertex|offlinePrimaryVertices");
+   vertices -> Branch("n", &nv, "n/I");
+   vertices -> Branch("x", x, "x[n]/F");
+   vertices -> Branch("y", y, "y[n]/F");
+   vertices -> Branch("z", z, "z[n]/F");
+   vertices -> Branch("xe", xe, "xe[n]/F");
+   vertices -> Branch("ye", ye, "ye[n]/F");
+   vertices -> Branch("ze", ze, "ze[n]/F");
+   vertices -> Branch("fake", fake, "fake[n]/O");
+   vertices -> Branch("chi2", chi2, "chi2[n]/F");
+   vertices -> Branch("ndof", ndof, "ndof[n]/F");
+   vertices -> Branch("rho", rho, "rho[n]/F");
+   TTree * genParticles = new TTree("prunedGenParticles", "reco::GenParticle|prunedGenParticles");
+   genParticles -> Branch("n", &ng, "n/I");
+   genParticles -> Branch("pt", gpt, "pt[n]/F");
+   genParticles -> Branch("eta", geta, "eta[n]/F");
+   genParticles -> Branch("phi", gphi, "phi[n]/F");
+   genParticles -> Branch("e", ge, "e[n]/F");
+   genParticles -> Branch("q", gq, "q[n]/I");
+   genParticles -> Branch("pdg", pdg, "pdg[n]/I");
+   genParticles -> Branch("status", status, "status[n]/I");
+   genParticles -> Branch("higgs_dau", higgs_dau, "higgs_dau[n]/O");
+   if ( autoflush != 0 )
+   {
+      eventInfo    -> SetAutoFlush(autoflush);
+      candidates   -> SetAutoFlush(autoflush);
+      vertices     -> SetAutoFlush(autoflush);
+      genParticles -> SetAutoFlush(autoflush);
+   }
+
+   for ( int i = 0 ; i < nevents ; ++i )
+   {
+      event = i+1;
+      run = 1;
+      lumisection = 1 + i/100;
+      n = i%5;
+      for ( int j = 0 ; j < n ; ++j )
+      {
+         pt[j]  = i+1+j;
+         eta[j] = 0.1*j;
+         phi[j] = 0.2*j;
+         e[j]   = pt[j]*std::cosh(eta[j]);
+         q[j]   = 0;
+      }
+      nv = 1 + i%4;
+      for ( int j = 0 ; j < nv ; ++j )
+      {
+         x[j] = y[j] = 0.01;
+         z[j] = 0.5*j;
+         xe[j] = ye[j] = ze[j] = 0.001;
+         chi2[j] = 10;
+         ndof[j] = 10;
+         rho[j]  = 0.014;
+         fake[j] = j == 2;
+      }
+      ng = 1 + i%3;
+      for ( int j = 0 ; j < ng ; ++j )
+      {
+         gpt[j]  = i+1+j;
+         geta[j] = 0.1*j;
+         gphi[j] = 0.2*j;
+         ge[j]   = gpt[j]*std::cosh(geta[j]);
+         gq[j]   = 0;
+         pdg[j]  = j%2 ? 21 : 5;
+         status[j] = 71;
+         higgs_dau[j] = false;
+      }
+      eventInfo    -> Fill();
+      candidates   -> Fill();
+      vertices     -> Fill();
+      genParticles -> Fill();
+   }
+   file -> Write();
+   file -> Close();
+   delete file;
+
+   std::ofstream list((name + ".txt").c_str());
+   list << name << ".root" << std::endl;
+   return name + ".txt";
+}
+
+#endif  // Analysis_Core_TestNtuple_h
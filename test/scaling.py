@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+#
+# End-to-end scaling benchmark of the analysis executables.
+#
+# For each input size the synthetic ntuples are generated once with
+# AnalysisNtupleGenerator. Each executable is then run on them with
+# 1..N processes, each one processing its shard of the events (ANALYSIS_SHARD),
+# in its own working directory. One CSV row is written per run with
+# the wall time, the events per second, the peak resident memory (largest
+# process and sum over processes) and the bytes read by the processes.
+#
+# Example:
+#    scaling.py --sizes 10000,100000 --processes 8 --csv scaling.csv
+
+from __future__ import print_function
+
+import argparse
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+BINARIES = ['AnalyseHBB', 'SimpleAnalysis', 'AnalysisJetsBtagEff']
+JET_TREES = ['selectedUpdatedPatJetsPuppi', 'slimmedJetsPuppi', 'slimmedJetsReapplyJEC',
+             'slimmedJetsPuppiReapplyJEC']
+
+
+def executable(bindir, name):
+   return os.path.join(bindir, name) if bindir else name
+
+
+def generate(args, size):
+   """ Generates the synthetic input of a given size (once) and returns its directory """
+   workdir = os.path.abspath(os.path.join(args.workdir, 'input_%d' % size))
+   filelist = os.path.join(workdir, 'rootFileList.txt')
+   if os.path.exists(filelist):
+      return workdir
+   if not os.path.isdir(workdir):
+      os.makedirs(workdir)
+   nfiles = max(1, size // args.events_per_file)
+   cmd = [executable(args.bindir, 'AnalysisNtupleGenerator'),
+          '--output', os.path.join(workdir, 'synthetic'),
+          '--list', filelist,
+          '--files', str(nfiles),
+          '--events', str(size // nfiles),
+          '--btageff', os.path.join(workdir, 'btageff.root')]
+   for tree in JET_TREES:
+      cmd += ['--jettree', tree]
+   print('Generating %d events in %d files' % (size, nfiles))
+   with open(os.path.join(workdir, 'generator.log'), 'w') as log:
+      subprocess.check_call(cmd, stdout=log, stderr=subprocess.STDOUT)
+   return workdir
+
+
+def command(args, binary, inputdir):
+   cmd = [executable(args.bindir, binary)]
+   if binary == 'AnalyseHBB':
+      cmd += ['-c', 'hbb.cfg']
+   if binary == 'AnalysisJetsBtagEff':
+      cmd += [os.path.join(inputdir, 'btageff.root')]
+   return cmd
+
+
+def bytes_read(pid):
+   """ Characters read by the process so far, including those from the page cache """
+   try:
+      with open('/proc/%d/io' % pid) as io:
+         for line in io:
+            if line.startswith('rchar:'):
+               return int(line.split()[1])
+   except (IOError, OSError):
+      pass
+   return None
+
+
+def run(args, binary, inputdir, nproc):
+   """ Runs nproc shards of a binary concurrently, returns the measurements """
+   rundir = os.path.join(os.path.abspath(args.workdir), 'run_%s_%s_%d' % (binary, os.path.basename(inputdir), nproc))
+   if os.path.isdir(rundir):
+      shutil.rmtree(rundir)
+   procs = {}
+   start = time.time()
+   for k in range(nproc):
+      shard = os.path.join(rundir, 'shard_%d' % k)
+      os.makedirs(shard)
+      shutil.copy(os.path.join(inputdir, 'rootFileList.txt'), shard)
+      if binary == 'AnalyseHBB':
+         shutil.copy(args.config, os.path.join(shard, 'hbb.cfg'))
+      env = dict(os.environ)
+      env['ANALYSIS_SHARD'] = '%d/%d' % (k, nproc)
+      log = open(os.path.join(shard, 'output.log'), 'w')
+      p = subprocess.Popen(command(args, binary, inputdir), cwd=shard, env=env,
+                           stdout=log, stderr=subprocess.STDOUT)
+      procs[p.pid] = {'proc': p, 'log': log, 'rchar': 0}
+
+   # wait for all shards, sampling the bytes read until they exit
+   rss = []
+   status = 0
+   running = set(procs)
+   while running:
+      for pid in list(running):
+         rchar = bytes_read(pid)
+         if rchar is not None:
+            procs[pid]['rchar'] = rchar
+         done, st, usage = os.wait4(pid, os.WNOHANG)
+         if done == 0:
+            continue
+         running.discard(pid)
+         procs[pid]['log'].close()
+         rss.append(usage.ru_maxrss / 1024.)   # kB on linux
+         if st != 0:
+            status = st
+      time.sleep(args.poll)
+   seconds = time.time() - start
+
+   return {'seconds': seconds,
+           'peak_rss_mb': max(rss) if rss else 0,
+           'sum_rss_mb': sum(rss),
+           'bytes_read': sum(p['rchar'] for p in procs.values()),
+           'status': status}
+
+
+def main():
+   parser = argparse.ArgumentParser(description='End-to-end scaling benchmark of the analysis executables.')
+   parser.add_argument('--binaries', default=','.join(BINARIES), help='comma separated executables to run')
+   parser.add_argument('--sizes', default='10000,100000', help='comma separated numbers of events')
+   parser.add_argument('--processes', type=int, default=4, help='maximum number of processes')
+   parser.add_argument('--events-per-file', type=int, default=50000, help='events per generated file')
+   parser.add_argument('--config', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'hbb.cfg'),
+                       help='configuration of AnalyseHBB')
+   parser.add_argument('--bindir', default='', help='directory of the executables (default: PATH)')
+   parser.add_argument('--workdir', default='scaling', help='directory for inputs and runs')
+   parser.add_argument('--csv', default='scaling.csv', help='output CSV file')
+   parser.add_argument('--poll', type=float, default=0.1, help='seconds between samples of the running processes')
+   parser.add_argument('--keep', action='store_true', help='keep the run directories')
+   args = parser.parse_args()
+
+   binaries = [b for b in args.binaries.split(',') if b]
+   sizes = [int(s) for s in args.sizes.split(',') if s]
+
+   with open(args.csv, 'w') as out:
+      writer = csv.writer(out)
+      writer.writerow(['binary', 'events', 'processes', 'seconds', 'events_per_second',
+                       'peak_rss_mb', 'sum_rss_mb', 'bytes_read', 'status'])
+      for size in sizes:
+         inputdir = generate(args, size)
+         for binary in binaries:
+            for nproc in range(1, args.processes + 1):
+               r = run(args, binary, inputdir, nproc)
+               rate = size / r['seconds'] if r['seconds'] > 0 else 0
+               writer.writerow([binary, size, nproc, '%.3f' % r['seconds'], '%.1f' % rate,
+                                '%.1f' % r['peak_rss_mb'], '%.1f' % r['sum_rss_mb'], r['bytes_read'], r['status']])
+               out.flush()
+               print('%-22s %10d events %3d processes %10.1f events/s %8.1f MB peak RSS%s' %
+                     (binary, size, nproc, rate, r['peak_rss_mb'], '' if r['status'] == 0 else '  FAILED'))
+               if not args.keep:
+                  shutil.rmtree(os.path.join(os.path.abspath(args.workdir),
+                                             'run_%s_%s_%d' % (binary, os.path.basename(inputdir), nproc)))
+   print('Results in %s' % args.csv)
+   return 0
+
+
+if __name__ == '__main__':
+   sys.exit(main())
@@ -0,0 +1,85 @@
+// Pipelined reading gives the same events and collections as the sequential
+// reading, also when the raw trees are accessed in the event loop and when
+// collections are added in the event loop.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+struct Event
+{
+   int event;
+   int run;
+   int n;
+   float sumPt;
+   int nRaw;
+   int nSelected;
+   bool operator==(const Event & e) const { return event == e.event && run == e.run && n == e.n && sumPt == e.sumPt && nRaw == e.nRaw && nSelected == e.nSelected; }
+};
+
+std::vector<Event> readEvents(const std::string & list, const bool & pipeline)
+{
+   Analysis analysis(list);
+   auto handle = analysis.addTree<Candidate>("Candidates", "MssmHbb/Events/candidates");
+   analysis.pipeline(pipeline);
+   std::vector<Event> events;
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      analysis.event(i);
+      auto candidates = analysis.collection(handle);
+      Event e;
+      e.event = analysis.event();
+      e.run   = analysis.run();
+      e.n     = candidates -> size();
+      e.sumPt = 0;
+      for ( int j = 0 ; j < candidates -> size() ; ++j )
+         e.sumPt += candidates -> at(j).pt();
+      // the raw tree in every third event only
+      e.nRaw  = i%3 == 0 ? analysis.tree(handle) -> collection().size() : e.n;
+      // a collection of the user, replaced in each event while the reader builds the next one
+      std::vector<Candidate> selected;
+      for ( int j = 0 ; j < candidates -> size() ; ++j )
+         if ( candidates -> at(j).pt() > i+1 ) selected.push_back(candidates -> at(j));
+      analysis.addCollection(std::move(selected), "SelectedCandidates");
+      e.nSelected = analysis.collection<Candidate>("SelectedCandidates") -> size();
+      events.push_back(e);
+   }
+   analysis.pipeline(false);
+   return events;
+}
+
+int main()
+{
+   std::string list = writeTestNtuple("testAnalysisPipeline", 20);
+
+   std::vector<Event> sequential = readEvents(list, false);
+   std::vector<Event> pipelined  = readEvents(list, true);
+
+   int failed = 0;
+   if ( sequential.size() != 20 || pipelined.size() != sequential.size() )
+   {
+      std::cout << "testAnalysisPipeline: " << sequential.size() << " and " << pipelined.size() << " events read" << std::endl;
+      return 1;
+   }
+   for ( size_t i = 0 ; i < sequential.size() ; ++i )
+   {
+      const Event & s = sequential[i];
+      const Event & p = pipelined[i];
+      if ( s.event != (int) i+1 || s.n != (int) i%5 || s.nRaw != s.n || s.nSelected != std::max(s.n-1, 0) ) ++failed;
+      if ( ! ( s == p ) )
+      {
+         std::cout << "testAnalysisPipeline: event " << i << " differs: event " << s.event << " / " << p.event
+                   << ", n " << s.n << " / " << p.n << ", raw n " << s.nRaw << " / " << p.nRaw << std::endl;
+         ++failed;
+      }
+   }
+   if ( failed ) return 1;
+   std::cout << "testAnalysisPipeline: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,47 @@
+// The shards of the input cover all events once, in the order of the input,
+// while numberEvents() stays the number of events of the whole input.
+
+#include <iostream>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   const int nevents = 1000;
+   const int nshards = 7;
+   // clusters of 64 entries, the shards are aligned to them
+   std::string list = writeTestNtuple("testAnalysisShard", nevents, 64);
+
+   int failed = 0;
+   for ( int byBytes = 0 ; byBytes < 2 ; ++byBytes )
+   {
+      int next = 0;
+      for ( int k = 0 ; k < nshards ; ++k )
+      {
+         Analysis analysis(list);
+         analysis.setShard(k, nshards, byBytes);
+         if ( analysis.numberEvents() != nevents ) ++failed;
+         if ( analysis.firstEvent() != next ) ++failed;
+         if ( analysis.size() != analysis.lastEvent() - analysis.firstEvent() ) ++failed;
+         if ( k < nshards-1 && analysis.lastEvent() % 64 != 0 ) ++failed;
+         for ( int i = 0 ; i < analysis.size() ; ++i )
+         {
+            analysis.event(i);
+            if ( analysis.event() != next+1 ) ++failed;
+            ++next;
+         }
+      }
+      if ( next != nevents ) ++failed;
+   }
+   if ( failed )
+   {
+      std::cout << "testAnalysisShard: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testAnalysisShard: ok" << std::endl;
+   return 0;
+}
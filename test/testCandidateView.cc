@@ -0,0 +1,57 @@
+// The candidates of a view of jets are the jets themselves, stepped over with
+// the size of a Jet, and the object views give the same objects.
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/CandidateView.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   std::vector<Jet> jets;
+   for ( int i = 0 ; i < 5 ; ++i )
+      jets.push_back(Jet(10.*(i+1), 0.5*i, 0.3*i, 20.*(i+1)));
+
+   int failed = 0;
+
+   CandidateView view(jets);
+   if ( view.size() != jets.size() || view.empty() ) ++failed;
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+   {
+      // no copies, the addresses are those of the jets
+      if ( &view[i] != static_cast<const Candidate *>(&jets[i]) ) ++failed;
+      if ( view.at(i).pt() != jets[i].pt() ) ++failed;
+   }
+   size_t n = 0;
+   for ( auto & cand : view )
+   {
+      if ( &cand != static_cast<const Candidate *>(&jets[n]) ) ++failed;
+      ++n;
+   }
+   if ( n != jets.size() ) ++failed;
+   bool thrown = false;
+   try { view.at(jets.size()); } catch ( std::out_of_range & ) { thrown = true; }
+   if ( ! thrown ) ++failed;
+
+   ObjectView<Jet> objects(jets.data()+1, 3);
+   if ( objects.size() != 3 || &objects[0] != &jets[1] || objects.end() != jets.data()+4 ) ++failed;
+   CandidateView candidates = objects.candidates();
+   if ( candidates.size() != 3 || &candidates[2] != static_cast<const Candidate *>(&jets[3]) ) ++failed;
+
+   CandidateView none;
+   if ( ! none.empty() || none.begin() != none.end() ) ++failed;
+   if ( ! CandidateView(std::vector<Jet>()).empty() ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testCandidateView: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testCandidateView: ok" << std::endl;
+   return 0;
+}
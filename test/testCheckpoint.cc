@@ -0,0 +1,92 @@
+// A loop interrupted after a checkpoint and resumed from it gives the same
+// histograms, counters and number of events of the range as an uninterrupted
+// loop, and a checkpoint of another job is not used.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include "TH1D.h"
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+struct Result
+{
+   std::vector<double> histogram;
+   std::vector<unsigned int> counters;
+   int events;
+   bool resumed;
+};
+
+// loops over the events [10,190) with a checkpoint every 25 events; stops before the event interrupt (-1: never)
+Result loop(const std::string & list, const std::string & checkpoint, const int & interrupt, const std::string & config = "")
+{
+   Analysis analysis(list);
+   analysis.setRange(10, 190);
+   auto handle = analysis.addTree<Candidate>("Candidates", "MssmHbb/Events/candidates");
+   TH1D * pt = new TH1D("pt", "", 50, 0, 250);
+   std::vector<unsigned int> counters(3, 0);
+   analysis.checkpointHistogram(pt);
+   analysis.checkpointCounters("cf", counters);
+
+   Result result;
+   result.resumed = analysis.checkpoint(checkpoint, 25, 0, config);
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      if ( analysis.firstEvent() + i == interrupt ) break;
+      analysis.event(i);
+      auto candidates = analysis.collection(handle);
+      ++counters[0];
+      if ( candidates -> size() < 2 ) continue;
+      ++counters[1];
+      for ( int j = 0 ; j < candidates -> size() ; ++j )
+         pt -> Fill(candidates -> at(j).pt());
+      if ( candidates -> at(0).pt() > 100 ) ++counters[2];
+   }
+   for ( int b = 0 ; b <= pt -> GetNbinsX()+1 ; ++b )
+      result.histogram.push_back(pt -> GetBinContent(b));
+   result.counters = counters;
+   result.events = analysis.rangeSize();
+   delete pt;
+   return result;
+}
+
+int main()
+{
+   TH1::AddDirectory(false);
+   std::string list = writeTestNtuple("testCheckpoint", 200, 16);
+   std::remove("testCheckpoint_full.root");
+   std::remove("testCheckpoint_interrupted.root");
+
+   int failed = 0;
+   Result full = loop(list, "testCheckpoint_full.root", -1);
+   if ( full.resumed || full.events != 180 || full.counters[0] != 180 ) ++failed;
+
+   // interrupted at event 97, the last checkpoint is at event 85
+   Result interrupted = loop(list, "testCheckpoint_interrupted.root", 97);
+   if ( interrupted.resumed || interrupted.counters[0] != 87 ) ++failed;
+   // another job does not resume from it
+   Result other = loop(list, "testCheckpoint_interrupted.root", 11, "another config");
+   if ( other.resumed || other.counters[0] != 1 ) ++failed;
+   Result resumed = loop(list, "testCheckpoint_interrupted.root", -1);
+   if ( ! resumed.resumed ) ++failed;
+
+   if ( resumed.histogram != full.histogram || resumed.counters != full.counters || resumed.events != full.events )
+   {
+      std::cout << "testCheckpoint: the resumed loop differs, " << resumed.counters[0] << " / " << full.counters[0]
+                << " events counted, " << resumed.events << " / " << full.events << " events in the range" << std::endl;
+      ++failed;
+   }
+
+   if ( failed )
+   {
+      std::cout << "testCheckpoint: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testCheckpoint: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,61 @@
+// The views keep the indices of the objects in the collection through
+// filter, select and the pt orderings, and count as the objects they see.
+
+#include <iostream>
+#include <vector>
+
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/CollectionView.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   const float pts[] = { 5, 30, 12, 50, 25, 1 };
+   std::vector<Jet> jets;
+   for ( auto & pt : pts )
+      jets.push_back(Jet(pt, 0., 0., pt));
+   ObjectView<Jet> objects(jets);
+
+   int failed = 0;
+
+   // filter keeps the order, partialSortByPt orders the first objects
+   CollectionView<Jet> view(objects);
+   view.filter([](const Jet & jet) { return jet.pt() > 2; }).partialSortByPt(2);
+   if ( view.size() != 5 ) ++failed;
+   if ( view.index(0) != 3 || view.index(1) != 1 ) ++failed;
+   if ( &view[0] != &jets[3] ) ++failed;
+   if ( view.countPtMin(20) != 3 ) ++failed;
+
+   // leading is pt ordered, countPtMin then a binary search
+   CollectionView<Jet> leading(objects);
+   leading.leading(3);
+   if ( leading.size() != 3 ) ++failed;
+   if ( leading.index(0) != 3 || leading.index(1) != 1 || leading.index(2) != 4 ) ++failed;
+   if ( leading.countPtMin(26) != 2 || leading.countPtMin(100) != 0 || leading.countPtMin(0) != 3 ) ++failed;
+   float sum = 0;
+   for ( auto & jet : leading ) sum += jet.pt();
+   if ( sum != 105 ) ++failed;
+
+   // select by positions in the view, in the order of the positions
+   leading.select(std::vector<unsigned int>{2, 0});
+   if ( leading.size() != 2 || leading.index(0) != 4 || leading.index(1) != 3 ) ++failed;
+
+   // sortByPt of the whole collection
+   CollectionView<Jet> sorted(objects);
+   sorted.sortByPt();
+   for ( size_t i = 1 ; i < sorted.size() ; ++i )
+      if ( sorted[i].pt() > sorted[i-1].pt() ) ++failed;
+   if ( sorted.count([](const Jet & jet) { return jet.pt() < 10; }) != 2 ) ++failed;
+
+   if ( ! CollectionView<Jet>().empty() ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testCollectionView: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testCollectionView: ok" << std::endl;
+   return 0;
+}
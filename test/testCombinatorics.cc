@@ -0,0 +1,65 @@
+// The pair kinematics of Combinatorics agree with those of the four-vectors
+// of the candidates, and combinations() enumerates and prunes as expected.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/Combinatorics.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   // pt, eta, phi, e; jets 1 and 2 across the phi = pi boundary
+   const float p4s[6][4] = { {50,0.1,0.2,60}, {40,-1.,3.0,70}, {30,2.,-3.0,120}, {20,0.5,1.,25}, {15,-2.,0.,60}, {10,1.,2.,20} };
+   std::vector<Jet> jets;
+   for ( auto & p : p4s )
+      jets.push_back(Jet(p[0], p[1], p[2], std::max(p[3], p[0]*(float)std::cosh(p[1]))));
+
+   int failed = 0;
+   auto differ = [](const double & a, const double & b) { return std::fabs(a-b) > 1e-3*std::max(1., std::fabs(b)); };
+
+   ObjectView<Jet> view(jets);
+   Combinatorics comb(view);
+   if ( comb.size() != 6 || comb.nPairs() != 15 ) ++failed;
+   for ( size_t p = 0 ; p < comb.nPairs() ; ++p )
+   {
+      auto ij = comb.pairObjects(p);
+      size_t i = ij.first;
+      size_t j = ij.second;
+      if ( comb.pair(i,j) != p || comb.pair(j,i) != p ) ++failed;
+      if ( differ(comb.mass(i,j), (jets[i].p4()+jets[j].p4()).M()) ) ++failed;
+      if ( differ(comb.deltaR(i,j), jets[i].deltaR(jets[j])) ) ++failed;
+      if ( differ(comb.deltaEta(i,j), jets[i].eta()-jets[j].eta()) || comb.deltaEta(j,i) != -comb.deltaEta(i,j) ) ++failed;
+      if ( std::fabs(comb.deltaPhi(i,j)) > M_PI ) ++failed;
+   }
+   // 3 - (-3) folded to 6 - 2pi
+   if ( differ(comb.deltaPhi(1,2), 6-2*M_PI) || differ(comb.deltaPhi(2,1), 2*M_PI-6) ) ++failed;
+   if ( differ(comb.mass(std::vector<size_t>{0,1}), comb.mass(0,1)) ) ++failed;
+
+   // the first n objects only
+   Combinatorics leading(view, 3);
+   if ( leading.size() != 3 || leading.nPairs() != 3 || leading.mass(0,2) != comb.mass(0,2) ) ++failed;
+   if ( Combinatorics(view, 1).nPairs() != 0 ) ++failed;
+
+   // k-combinations in lexicographic order
+   auto none = [](const std::vector<size_t> &) {};
+   if ( comb.combinations(2, none) != 15 || comb.combinations(3, none) != 20 ) ++failed;
+   if ( comb.combinations(6, none) != 1  || comb.combinations(7, none) != 0  ) ++failed;
+   // those with object 0 rejected when it is added: C(5,3)
+   size_t n = comb.combinations(3,
+                                [](const std::vector<size_t> & c) { return c.back() != 0; },
+                                [&failed](const std::vector<size_t> & c) { if ( c[0] == 0 || c[0] >= c[1] || c[1] >= c[2] ) ++failed; });
+   if ( n != 10 ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testCombinatorics: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testCombinatorics: ok" << std::endl;
+   return 0;
+}
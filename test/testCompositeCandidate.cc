@@ -0,0 +1,56 @@
+// A composite candidate points to its daughters and has the four-momentum
+// and the charge of their sum.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "Analysis/Core/interface/Muon.h"
+#include "Analysis/Core/interface/CompositeCandidate.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   std::vector<Muon> muons;
+   muons.push_back(Muon(20., 0.5, 0.1,  30., -1));
+   muons.push_back(Muon(45., 1.2, 2.8,  90., +1));
+   muons.push_back(Muon(30., -0.7, -2.9, 40., +1));
+   ObjectView<Muon> objects(muons);
+
+   int failed = 0;
+   auto differ = [](const double & a, const double & b) { return std::fabs(a-b) > 1e-3*std::max(1., std::fabs(b)); };
+
+   // by indices in the collection
+   CompositeCandidate pair(objects, std::vector<size_t>{0, 2});
+   TLorentzVector sum = muons[0].p4() + muons[2].p4();
+   if ( pair.nDaughters() != 2 ) ++failed;
+   if ( pair.daughter(0) != &muons[0] || pair.daughter(1) != &muons[2] ) ++failed;
+   if ( pair.daughterIndex(1) != 2 ) ++failed;
+   if ( differ(pair.m(), sum.M()) || pair.mass() != pair.m() ) ++failed;
+   if ( differ(pair.pt(), sum.Pt()) || differ(pair.eta(), sum.Eta()) || differ(pair.phi(), sum.Phi()) ) ++failed;
+   if ( pair.q() != 0 ) ++failed;
+
+   // the two leading of a pt ordered view, indices in the collection
+   CollectionView<Muon> view(objects);
+   view.sortByPt();
+   CompositeCandidate leading(view, 2);
+   sum = muons[1].p4() + muons[2].p4();
+   if ( leading.nDaughters() != 2 || leading.daughterIndex(0) != 1 || leading.daughterIndex(1) != 2 ) ++failed;
+   if ( differ(leading.m(), sum.M()) || leading.q() != 2 ) ++failed;
+   // as any candidate
+   if ( differ(leading.deltaR(muons[0]), sum.DeltaR(muons[0].p4())) ) ++failed;
+
+   // more daughters asked than in the view
+   if ( CompositeCandidate(view, 5).nDaughters() != 3 ) ++failed;
+   if ( CompositeCandidate().nDaughters() != 0 || CompositeCandidate().m() != 0 ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testCompositeCandidate: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testCompositeCandidate: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,81 @@
+// The deltaR2 kernel and DeltaRMatrix agree with the deltaR of the candidates,
+// for one and two collections, and the per object minima and isolation agree
+// with the matrix elements.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <random>
+
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/Muon.h"
+#include "Analysis/Core/interface/DeltaRMatrix.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   std::mt19937 gen(1);
+   std::uniform_real_distribution<float> eta(-2.5, 2.5), phi(-M_PI, M_PI);
+   std::vector<Jet>  jets;
+   std::vector<Muon> muons;
+   for ( int i = 0 ; i < 7 ; ++i ) jets.push_back(Jet(50., eta(gen), phi(gen), 200.));
+   for ( int i = 0 ; i < 3 ; ++i ) muons.push_back(Muon(20., eta(gen), phi(gen), 80., -1));
+
+   int failed = 0;
+   auto differ = [](const double & a, const double & b) { return std::fabs(a-b) > 1e-4*std::max(1., std::fabs(b)); };
+
+   // the kernel, also for phi out of [-pi,pi]
+   if ( differ(deltaPhi(3., -3.), 6-2*M_PI) || differ(deltaPhi(-3., 3.), 2*M_PI-6) ) ++failed;
+   if ( differ(deltaPhi(0.5+4*M_PI, 0.2), 0.3) ) ++failed;
+   if ( deltaPhi(1., 1.) != 0 || std::fabs(deltaPhi(M_PI, 0.)) > M_PI+1e-6 ) ++failed;
+   if ( differ(deltaR2(1., 3., 0., -3.), 1+std::pow(6-2*M_PI,2)) ) ++failed;
+
+   // single collection, upper triangle
+   ObjectView<Jet> jetView(jets);
+   DeltaRMatrix single(jetView);
+   if ( ! single.symmetric() || single.rows() != 7 || single.columns() != 7 || single.values().size() != 21 ) ++failed;
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+      for ( size_t j = 0 ; j < jets.size() ; ++j )
+      {
+         float dR = i == j ? 0 : jets[i].deltaR(jets[j]);
+         if ( differ(single.deltaR2(i,j), dR*dR) ) ++failed;
+      }
+   std::vector<float> mins = single.minDeltaR2PerObject();
+   float min = 1e9;
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+   {
+      float mini = 1e9;
+      for ( size_t j = 0 ; j < jets.size() ; ++j )
+         if ( j != i ) mini = std::min(mini, single.deltaR2(i,j));
+      if ( mins[i] != mini ) ++failed;
+      min = std::min(min, mini);
+   }
+   if ( single.minDeltaR2() != min ) ++failed;
+
+   // first n objects only
+   if ( DeltaRMatrix(jetView, 3).values().size() != 3 || DeltaRMatrix(jetView, 1).values().size() != 0 ) ++failed;
+
+   // two collections, row major
+   ObjectView<Muon> muonView(muons);
+   DeltaRMatrix cross(jetView, muonView);
+   if ( cross.symmetric() || cross.rows() != 7 || cross.columns() != 3 ) ++failed;
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+      for ( size_t j = 0 ; j < muons.size() ; ++j )
+      {
+         float dR = jets[i].deltaR(muons[j]);
+         if ( differ(cross.deltaR2(i,j), dR*dR) ) ++failed;
+      }
+   std::vector<bool> isolated = cross.isolated(1.0);
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+      if ( isolated[i] != ( cross.nWithin(i, 1.0) == 0 ) ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testDeltaRMatrix: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testDeltaRMatrix: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,82 @@
+// The ranges of GenParticleIndex by |pdgId| and status hold the same
+// particles as a scan of the collection, and the Higgs daughters are all
+// those flagged.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+
+#include "Analysis/Core/interface/GenParticleIndex.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   std::mt19937 gen(3);
+   const int pdgs[] = { 1, -1, 2, 5, -5, 21, 13, -13, 36, 0, 22 };
+   std::vector<GenParticle> particles;
+   for ( int i = 0 ; i < 300 ; ++i )
+   {
+      GenParticle p;
+      p.pdgId(pdgs[gen()%11]);
+      p.status(1 + gen()%80);
+      p.higgsDaughter(gen()%17 == 0);
+      particles.push_back(p);
+   }
+   GenParticleIndex index((ObjectView<GenParticle>(particles)));
+
+   int failed = 0;
+   if ( index.size() != particles.size() || &index.particle(7) != &particles[7] ) ++failed;
+
+   for ( int pdg : { 0, 1, -5, 5, 13, 21, 36, 22, 7 } )
+   {
+      for ( int smin : { 1, 3, 61, 71 } )
+      {
+         for ( int smax : { 1, 3, 72, 1000 } )
+         {
+            GenParticleIndex::Range range = index.withPdg(pdg).status(smin, smax);
+            std::vector<unsigned int> found;
+            for ( size_t i = 0 ; i < range.size() ; ++i )
+            {
+               found.push_back(range.index(i));
+               if ( &range[i] != &particles[range.index(i)] ) ++failed;
+            }
+            // within a status, in the order of the collection
+            for ( size_t i = 1 ; i < range.size() ; ++i )
+               if ( range[i].status() == range[i-1].status() && range.index(i) < range.index(i-1) ) ++failed;
+            std::vector<unsigned int> scan;
+            for ( unsigned int i = 0 ; i < particles.size() ; ++i )
+               if ( std::abs(particles[i].pdgId()) == std::abs(pdg) && particles[i].status() >= smin && particles[i].status() <= smax )
+                  scan.push_back(i);
+            std::sort(found.begin(), found.end());
+            if ( found != scan ) ++failed;
+            size_t n = 0;
+            for ( auto & p : range )
+            {
+               if ( std::abs(p.pdgId()) != std::abs(pdg) ) ++failed;
+               ++n;
+            }
+            if ( n != range.size() || range.empty() != ( n == 0 ) ) ++failed;
+         }
+      }
+   }
+
+   size_t nhiggs = 0;
+   for ( auto & p : particles ) nhiggs += p.higgsDaughter();
+   if ( index.higgsDaughters().size() != nhiggs ) ++failed;
+   for ( auto & p : index.higgsDaughters() )
+      if ( ! p -> higgsDaughter() ) ++failed;
+
+   if ( GenParticleIndex().size() != 0 || ! GenParticleIndex().withPdg(5).empty() ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testGenParticleIndex: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testGenParticleIndex: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,86 @@
+// The nominal of JetVariations is the JER smearing with the central scale
+// factor and the same random numbers as the JER variations, the JEC
+// variations are scaled from it, and the pt orderings and masses follow the
+// varied momenta.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "Analysis/Core/interface/Jet.h"
+#include "Analysis/Core/interface/JetVariations.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   std::vector<Jet> jets;
+   const float pts[] = { 100, 98, 60, 30 };
+   for ( int i = 0 ; i < 4 ; ++i )
+   {
+      Jet jet(pts[i], 0.5*i-0.7, 1.1*i, 1.5*pts[i]);
+      jet.JerResolution(0.1);
+      jet.JerSf(1.1);
+      jet.JerSfUp(1.2);
+      jet.JerSfDown(1.0);
+      jet.jecUncert(0.03);
+      jets.push_back(jet);
+   }
+   RandomStream random(1, 1, 42, "Jets");
+   JetVariations vars(CollectionView<Jet>(ObjectView<Jet>(jets)), random);
+   vars.addJerJec();
+
+   int failed = 0;
+   auto differ = [](const double & a, const double & b) { return std::fabs(a-b) > 1e-3*std::max(1., std::fabs(b)); };
+
+   if ( vars.size() != 5 || vars.nJets() != 4 ) ++failed;
+   if ( vars.name(0) != "nominal" || vars.type(0) != JetVariations::JER || vars.nSigma(0) != 0 ) ++failed;
+   int jerUp = vars.find("jerUp"), jerDown = vars.find("jerDown"), jecUp = vars.find("jecUp"), jecDown = vars.find("jecDown");
+   if ( jerUp < 0 || jerDown < 0 || jecUp < 0 || jecDown < 0 || vars.find("none") >= 0 ) ++failed;
+   // a variation is added once
+   if ( vars.add("jerUp", JetVariations::JER, 1) != (size_t) jerUp || vars.size() != 5 ) ++failed;
+
+   for ( size_t i = 0 ; i < jets.size() ; ++i )
+   {
+      const Jet & jet = jets[i];
+      double gaus = random.gaus(i, 0);
+      auto smeared = [&](const double & sf) { return jet.pt() + std::sqrt(sf*sf-1)*jet.JerResolution()*jet.pt()*gaus; };
+      // the nominal is smeared, with the numbers of the JER variations
+      if ( differ(vars.pt(0,i), smeared(1.1)) ) ++failed;
+      if ( differ(vars.pt(jerUp,i), smeared(1.2)) ) ++failed;
+      // scale factor 1, not smeared
+      if ( differ(vars.pt(jerDown,i), jet.pt()) ) ++failed;
+      // JEC from the nominal
+      if ( differ(vars.pt(jecUp,i),   1.03*vars.pt(0,i)) ) ++failed;
+      if ( differ(vars.pt(jecDown,i), 0.97*vars.pt(0,i)) ) ++failed;
+      if ( differ(vars.e(jecUp,i)/vars.pt(jecUp,i), vars.e(0,i)/vars.pt(0,i)) ) ++failed;
+      // eta and phi unchanged
+      TLorentzVector p4 = vars.p4(jecUp,i);
+      if ( differ(p4.Eta(), jet.eta()) || differ(p4.Phi(), jet.phi()) ) ++failed;
+   }
+
+   for ( size_t v = 0 ; v < vars.size() ; ++v )
+   {
+      // the pt ordering, the leading jets and the counts follow the varied pt
+      const std::vector<unsigned int> & order = vars.ptOrder(v);
+      for ( size_t k = 1 ; k < order.size() ; ++k )
+         if ( vars.pt(v,order[k]) > vars.pt(v,order[k-1]) ) ++failed;
+      CollectionView<Jet> leading = vars.leading(v, 2);
+      if ( leading.size() != 2 || &leading[0] != &jets[order[0]] || &leading[1] != &jets[order[1]] ) ++failed;
+      size_t n = 0;
+      for ( size_t i = 0 ; i < jets.size() ; ++i )
+         if ( vars.pt(v,i) >= 50 ) ++n;
+      if ( vars.countPtMin(v, 50) != n ) ++failed;
+      // the mass of the varied four-vectors
+      if ( differ(vars.m(v,0,2), (vars.p4(v,0)+vars.p4(v,2)).M()) ) ++failed;
+   }
+
+   if ( failed )
+   {
+      std::cout << "testJetVariations: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testJetVariations: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,72 @@
+// The closed form inverse of the MET covariance and the significance agree
+// with the direct computation, for single METs and the column kernel.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "Analysis/Core/interface/MET.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   int failed = 0;
+   auto differ = [](const double & a, const double & b) { return std::fabs(a-b) > 1e-4*std::max(1., std::fabs(b)); };
+
+   // the inverse times the matrix is the identity
+   METSignificanceMatrix c{400., 30., 30., 250.};
+   if ( differ(c.determinant(), 400.*250.-30.*30.) ) ++failed;
+   METSignificanceMatrix inv = c.inverse();
+   for ( int i = 0 ; i < 2 ; ++i )
+      for ( int j = 0 ; j < 2 ; ++j )
+      {
+         double p = inv(i,0)*c(0,j) + inv(i,1)*c(1,j);
+         if ( differ(p, i == j ? 1 : 0) ) ++failed;
+      }
+   // singular
+   METSignificanceMatrix singular{1., 2., 2., 4.};
+   METSignificanceMatrix zero = singular.inverse();
+   if ( zero.xx != 0 || zero.xy != 0 || zero.yx != 0 || zero.yy != 0 ) ++failed;
+
+   // (px,py) C^-1 (px,py)^T
+   MET met(30., -40., 0.);
+   met.significanceMatrix(c.xx, c.xy, c.yx, c.yy);
+   if ( met.significanceMatrix()(0,1) != c.xy || met.significanceMatrix()(1,0) != c.yx ) ++failed;
+   double px = met.px(), py = met.py();
+   double s = px*(inv.xx*px + inv.xy*py) + py*(inv.yx*px + inv.yy*py);
+   if ( differ(met.significance(), s) ) ++failed;
+   // a diagonal covariance gives the sum of the squared pulls
+   met.significanceMatrix(100., 0., 0., 400.);
+   if ( differ(met.significance(), 30.*30./100. + 40.*40./400.) ) ++failed;
+   met.significanceMatrix(singular.xx, singular.xy, singular.yx, singular.yy);
+   if ( met.significance() != 0 ) ++failed;
+
+   // the column kernel, as the METs one by one
+   const size_t n = 5;
+   std::vector<float> pxs(n), pys(n), xx(n), xy(n), yx(n), yy(n), out(n);
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      pxs[i] = 10.*i - 20;
+      pys[i] = 5.*i + 3;
+      xx[i]  = 100. + 50*i;
+      xy[i]  = yx[i] = 10.*i;
+      yy[i]  = 200. - 20*i;
+   }
+   metSignificance(pxs.data(), pys.data(), xx.data(), xy.data(), yx.data(), yy.data(), n, out.data());
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      MET m(pxs[i], pys[i], 0.);
+      m.significanceMatrix(xx[i], xy[i], yx[i], yy[i]);
+      if ( differ(out[i], m.significance()) ) ++failed;
+   }
+
+   if ( failed )
+   {
+      std::cout << "testMET: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testMET: ok" << std::endl;
+   return 0;
+}
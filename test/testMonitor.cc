@@ -0,0 +1,77 @@
+// The counters of the event loop: events read and preselected, and the bytes
+// read per tree, decompressed and as compressed baskets, with and without a
+// preselection that leaves the object trees unread for the rejected events.
+
+#include <iostream>
+#include <string>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+const int nevents = 300;
+
+MonitorInfo readEvents(const std::string & list, const bool & preselection)
+{
+   Analysis analysis(list);
+   auto handle = analysis.addTree<Candidate>("Candidates", "MssmHbb/Events/candidates");
+   if ( preselection )
+   {
+      analysis.addPreselection([](Analysis & a) { return a.event()%3 != 0; });
+      analysis.stagedReading(true);
+   }
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      if ( ! analysis.event(i) ) continue;
+      analysis.collection(handle);
+   }
+   return analysis.monitorInfo();
+}
+
+int main()
+{
+   std::string list = writeTestNtuple("testMonitor", nevents, 50);
+   TFile * file = TFile::Open("testMonitor.root");
+   Long64_t fileBytes = file -> GetSize();
+   Long64_t treeZipBytes = ((TTree*) file -> Get("MssmHbb/Events/candidates")) -> GetZipBytes();
+   file -> Close();
+   delete file;
+
+   // the event information has 3 ints, the candidates n and 5 arrays of n numbers of 4 bytes;
+   // the constructor of Analysis reads one event to find out whether it is MC
+   long eventInfoBytes = 12*(nevents+1);
+   long candidateBytes = 0, preselectedBytes = 0, npreselected = 0;
+   for ( int i = 0 ; i < nevents ; ++i )
+   {
+      candidateBytes += 4 + 20*(i%5);
+      if ( (i+1)%3 == 0 ) continue;
+      preselectedBytes += 4 + 20*(i%5);
+      ++npreselected;
+   }
+
+   int failed = 0;
+   MonitorInfo all = readEvents(list, false);
+   if ( all.events != nevents || all.preselected != nevents ) ++failed;
+   if ( all.treeBytes["EventInfo"] != eventInfoBytes || all.treeBytes["Candidates"] != candidateBytes ) ++failed;
+   // all baskets of the candidates, each with the header of its key
+   if ( all.treeZipBytes["Candidates"] < treeZipBytes || all.treeZipBytes["Candidates"] > fileBytes ) ++failed;
+   if ( all.bytesRead <= 0 || all.filesOpened < 1 ) ++failed;
+
+   MonitorInfo preselected = readEvents(list, true);
+   if ( preselected.events != nevents || preselected.preselected != npreselected ) ++failed;
+   if ( preselected.treeBytes["EventInfo"] != eventInfoBytes || preselected.treeBytes["Candidates"] != preselectedBytes ) ++failed;
+   if ( preselected.treeZipBytes["Candidates"] <= 0 || preselected.treeZipBytes["Candidates"] > all.treeZipBytes["Candidates"] ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testMonitor: " << failed << " failures; candidate bytes " << all.treeBytes["Candidates"] << " / " << candidateBytes
+                << ", preselected " << preselected.preselected << " / " << npreselected << std::endl;
+      return 1;
+   }
+   std::cout << "testMonitor: ok" << std::endl;
+   return 0;
+}
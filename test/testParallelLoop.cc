@@ -0,0 +1,103 @@
+// The chunks of the work-stealing scheduler cover the range of events once,
+// each within one cluster of one file, and the parallel event loop processes
+// every event of the range exactly once, in the right file.
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "Analysis/Core/interface/ChunkScheduler.h"
+#include "Analysis/Core/interface/ParallelLoop.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   // three files, one of them empty, with clusters of 32 entries
+   const int sizes[] = { 300, 0, 500 };
+   std::ofstream list("testParallelLoop.txt");
+   for ( int f = 0 ; f < 3 ; ++f )
+   {
+      std::string name = "testParallelLoop_" + std::to_string(f);
+      writeTestNtuple(name, sizes[f], 32);
+      list << name << ".root" << std::endl;
+   }
+   list.close();
+   const int nevents = 800;
+   const int workers = 4;
+
+   int failed = 0;
+   Analysis analysis("testParallelLoop.txt");
+   analysis.setRange(10, nevents-5);
+   FileManager * files = analysis.fileManager();
+   if ( files -> entries() != nevents ) ++failed;
+
+   // a worker alone takes its own chunks and then steals all the others
+   ChunkScheduler scheduler(files, analysis.firstEvent(), analysis.lastEvent(), workers);
+   std::vector<Chunk> chunks;
+   Chunk chunk;
+   while ( scheduler.next(1, chunk) ) chunks.push_back(chunk);
+   if ( (int) chunks.size() != scheduler.size() ) ++failed;
+   if ( scheduler.stolen(1) != scheduler.size() - ( scheduler.size()*2/workers - scheduler.size()/workers ) ) ++failed;
+   std::sort(chunks.begin(), chunks.end());
+   Long64_t next = analysis.firstEvent();
+   for ( auto & c : chunks )
+   {
+      if ( c.first != next || c.second <= c.first ) ++failed;
+      int index = files -> fileIndex(c.first);
+      if ( files -> fileIndex(c.second-1) != index ) ++failed;
+      // the boundaries are those of the clusters or of the range
+      Long64_t local = c.first - files -> offset(index);
+      if ( c.first != analysis.firstEvent() && local % 32 != 0 ) ++failed;
+      next = c.second;
+   }
+   if ( next != analysis.lastEvent() ) ++failed;
+
+   // the parallel loop
+   std::vector< std::vector<int> > hits(workers, std::vector<int>(nevents, 0));
+   std::vector<TTree *> trees(workers, nullptr);
+   std::vector<int> events(workers, 0);
+   std::vector<int> wrong(workers, 0);
+   ParallelLoop loop(analysis, workers);
+   loop.run([&](FileManager & files, const Long64_t & entry, const int & w)
+   {
+      if ( files.newFile() )
+      {
+         trees[w] = files.tree("MssmHbb/Events/EventInfo");
+         trees[w] -> SetBranchAddress("event", &events[w]);
+      }
+      trees[w] -> GetEntry(entry);
+      if ( events[w] != entry+1 ) ++wrong[w];
+      ++hits[w][files.offset(files.index()) + entry];
+   });
+   loop.listWorkers();
+
+   int processed = 0;
+   int nchunks = 0;
+   for ( int w = 0 ; w < workers ; ++w )
+   {
+      failed += wrong[w];
+      processed += loop.processed(w);
+      nchunks += loop.chunks(w);
+   }
+   if ( processed != analysis.size() || nchunks != scheduler.size() ) ++failed;
+   for ( int i = 0 ; i < nevents ; ++i )
+   {
+      int n = 0;
+      for ( int w = 0 ; w < workers ; ++w ) n += hits[w][i];
+      bool inRange = i >= analysis.firstEvent() && i < analysis.lastEvent();
+      if ( n != ( inRange ? 1 : 0 ) ) ++failed;
+   }
+
+   if ( failed )
+   {
+      std::cout << "testParallelLoop: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testParallelLoop: ok" << std::endl;
+   return 0;
+}
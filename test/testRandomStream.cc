@@ -0,0 +1,69 @@
+// Philox4x32-10 gives the known answers of Random123 (kat_vectors), and the
+// streams are reproducible functions of the event, collection, object and
+// variation.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "Analysis/Core/interface/RandomStream.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+int main()
+{
+   int failed = 0;
+
+   // known answer tests
+   const uint32_t kat[3][10] = {
+      { 0x00000000, 0x00000000, 0x00000000, 0x00000000,  0x00000000, 0x00000000,  0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+      { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,  0xffffffff, 0xffffffff,  0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+      { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344,  0xa4093822, 0x299f31d0,  0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+   for ( auto & v : kat )
+   {
+      uint32_t ctr[4] = { v[0], v[1], v[2], v[3] };
+      const uint32_t key[2] = { v[4], v[5] };
+      RandomStream::philox(ctr, key);
+      for ( int k = 0 ; k < 4 ; ++k )
+         if ( ctr[k] != v[6+k] )
+         {
+            std::cout << "testRandomStream: philox word " << k << " is " << std::hex << ctr[k] << " instead of " << v[6+k] << std::dec << std::endl;
+            ++failed;
+         }
+   }
+
+   // reproducible, and the same through the column interface
+   RandomStream stream(1, 2, 3, "Jets");
+   std::vector<double> draw0, draw1;
+   const size_t n = 10000;
+   stream.gaus(n, draw0, draw1);
+   double sum = 0, sum2 = 0;
+   for ( size_t i = 0 ; i < n ; ++i )
+   {
+      if ( draw0[i] != stream.gaus(i, 0) || draw1[i] != stream.gaus(i, 1) ) ++failed;
+      sum  += draw0[i] + draw1[i];
+      sum2 += draw0[i]*draw0[i] + draw1[i]*draw1[i];
+   }
+   if ( std::fabs(sum/(2*n)) > 0.05 || std::fabs(sum2/(2*n) - 1) > 0.05 ) ++failed;
+   if ( RandomStream(1, 2, 3, "Jets").uniform(7, 3) != stream.uniform(7, 3) ) ++failed;
+   for ( size_t i = 0 ; i < 100 ; ++i )
+   {
+      double u = stream.uniform(i, i%4);
+      if ( u <= 0 || u >= 1 ) ++failed;
+   }
+
+   // another event, collection or variation gives other numbers
+   if ( RandomStream(1, 2, 4, "Jets").gaus(0)    == stream.gaus(0) ) ++failed;
+   if ( RandomStream(1, 2, 3, "Muons").gaus(0)   == stream.gaus(0) ) ++failed;
+   if ( RandomStream(1, 2, 3, "Jets", 1).gaus(0) == stream.gaus(0) ) ++failed;
+   if ( stream.gaus(0, 0) == stream.gaus(0, 2) || stream.gaus(0) == stream.gaus(1) ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testRandomStream: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testRandomStream: ok" << std::endl;
+   return 0;
+}
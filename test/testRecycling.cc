@@ -0,0 +1,127 @@
+// Collections built in the storage of those of the previous event hold the
+// same objects as fresh ones, and the storage of a collection is not reused
+// while another collection pointing into it, by associated partons or
+// matched objects, is still held.
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+// the objects of all collections of an event as numbers
+std::vector<float> snapshot(Analysis & analysis)
+{
+   std::vector<float> s;
+   auto candidates = analysis.collection<Candidate>("Candidates");
+   for ( int j = 0 ; j < candidates -> size() ; ++j )
+   {
+      const Candidate & c = candidates -> at(j);
+      s.insert(s.end(), { c.pt(), c.eta(), c.phi(), c.e(), float(c.q()) });
+   }
+   auto particles = analysis.collection<GenParticle>("GenParticles");
+   for ( int j = 0 ; j < particles -> size() ; ++j )
+   {
+      const GenParticle & p = particles -> at(j);
+      s.insert(s.end(), { p.pt(), float(p.pdgId()), float(p.status()), float(p.higgsDaughter()) });
+   }
+   auto vertices = analysis.collection<Vertex>("Vertices");
+   for ( int j = 0 ; j < vertices -> size() ; ++j )
+   {
+      const Vertex & v = vertices -> at(j);
+      s.insert(s.end(), { v.z(), float(v.fake()), v.ndof() });
+   }
+   return s;
+}
+
+// keep: the collections of the previous event are held by the user, so that their storage is not reused
+std::vector< std::vector<float> > readEvents(const std::string & list, const bool & keep, int & reused)
+{
+   Analysis analysis(list);
+   analysis.addTree<Candidate>("Candidates", "MssmHbb/Events/candidates");
+   analysis.addTree<GenParticle>("GenParticles", "MssmHbb/Events/prunedGenParticles");
+   analysis.addTree<Vertex>("Vertices", "MssmHbb/Events/primaryVertices");
+   std::vector< std::vector<float> > events;
+   std::shared_ptr< Collection<Vertex> > previous;
+   const Vertex * storage = nullptr;
+   reused = 0;
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      analysis.event(i);
+      events.push_back(snapshot(analysis));
+      auto vertices = analysis.collection<Vertex>("Vertices");
+      if ( &vertices -> at(0) == storage ) ++reused;
+      storage = &vertices -> at(0);
+      if ( keep ) previous = vertices;
+   }
+   return events;
+}
+
+int main()
+{
+   std::string list = writeTestNtuple("testRecycling", 60);
+
+   int failed = 0;
+   int reused, reusedKept;
+   std::vector< std::vector<float> > recycled = readEvents(list, false, reused);
+   std::vector< std::vector<float> > fresh    = readEvents(list, true, reusedKept);
+   // the vertices of 1 to 4 objects, the storage is reused once it has grown to 4
+   if ( recycled.size() != 60 || recycled != fresh ) ++failed;
+   if ( reused < 50 || reusedKept != 0 ) ++failed;
+
+   // jets kept until the next event, with their partons and matched candidates
+   Analysis analysis(list);
+   auto candidates = analysis.addTree<Candidate>("Candidates", "MssmHbb/Events/candidates");
+   auto particles  = analysis.addTree<GenParticle>("GenParticles", "MssmHbb/Events/prunedGenParticles");
+   std::shared_ptr< Collection<Jet> > previousJets;
+   std::vector<float> previousPartons, previousMatched;
+   int npartons = 0;
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      analysis.event(i);
+      // the objects the jets of the previous event point to are still those of that event
+      if ( previousJets )
+      {
+         std::vector<float> partons, matched;
+         for ( int j = 0 ; j < previousJets -> size() ; ++j )
+         {
+            for ( auto & p : previousJets -> at(j).partons() ) partons.push_back(p -> pt());
+            const Candidate * m = previousJets -> at(j).matched("Candidates");
+            if ( m ) matched.push_back(m -> pt());
+         }
+         if ( partons != previousPartons || matched != previousMatched ) ++failed;
+      }
+
+      auto c = analysis.collection(candidates);
+      std::vector<Jet> jets;
+      for ( int j = 0 ; j < c -> size() ; ++j )
+         jets.push_back(Jet(c -> at(j).pt(), c -> at(j).eta(), c -> at(j).phi(), c -> at(j).e()));
+      previousJets = analysis.addCollection(std::move(jets), "Jets");
+      previousJets -> associatePartons(analysis.collection(particles), 0.05, 1., true);
+      analysis.match<Jet,Candidate>("Jets", "Candidates", 0.05);
+
+      previousPartons.clear();
+      previousMatched.clear();
+      for ( int j = 0 ; j < previousJets -> size() ; ++j )
+      {
+         for ( auto & p : previousJets -> at(j).partons() ) previousPartons.push_back(p -> pt());
+         const Candidate * m = previousJets -> at(j).matched("Candidates");
+         if ( m ) previousMatched.push_back(m -> pt());
+         if ( ! m || m -> pt() != previousJets -> at(j).pt() ) ++failed;
+      }
+      npartons += previousPartons.size();
+   }
+   if ( npartons == 0 ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testRecycling: " << failed << " failures, storage reused in " << reused << " events" << std::endl;
+      return 1;
+   }
+   std::cout << "testRecycling: ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,114 @@
+// Staged reading with a preselection builds the same collections as the
+// sequential reading for the preselected events, never reads the object
+// trees of the rejected events unless they are accessed, and the summary of
+// a tree read by another slot reads that tree first.
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+const std::string candidatesPath = "MssmHbb/Events/candidates";
+const std::string verticesPath   = "MssmHbb/Events/primaryVertices";
+
+struct Event
+{
+   int event;
+   bool selected;
+   int n;
+   float sumPt;
+   int nVertices;
+   int nGood;
+   bool operator==(const Event & e) const { return event == e.event && selected == e.selected && n == e.n && sumPt == e.sumPt && nVertices == e.nVertices && nGood == e.nGood; }
+};
+
+// mode 0: sequential, 1: preselection, 2: preselection and staged reading
+std::vector<Event> readEvents(const std::string & list, const int & mode, int & failed)
+{
+   Analysis analysis(list);
+   auto candidates = analysis.addTree<Candidate>("Candidates", candidatesPath);
+   auto vertices = analysis.addTree<Vertex>("Vertices", verticesPath);
+   auto summary = analysis.addVertexSummary("VertexSummary", verticesPath);
+   if ( mode > 0 ) analysis.addPreselection([](Analysis & a) { return a.event()%3 != 0; });
+   if ( mode > 1 ) analysis.stagedReading(true);
+   FileManager * files = analysis.fileManager();
+
+   std::vector<Event> events;
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      Event e;
+      e.selected = analysis.event(i);
+      e.event = analysis.event();
+      e.n = -1;
+      e.sumPt = 0;
+      e.nVertices = -1;
+      e.nGood = -1;
+      if ( mode == 0 ) e.selected = e.event%3 != 0;
+      if ( mode > 0 && e.selected != ( e.event%3 != 0 ) ) ++failed;
+
+      // the object trees of a rejected event are not read, nor those of any event before they are accessed
+      if ( mode > 0 && ( ! e.selected || mode == 2 ) )
+      {
+         if ( files -> tree(candidatesPath) -> GetReadEntry() == i ) ++failed;
+         if ( files -> tree(verticesPath) -> GetReadEntry() == i ) ++failed;
+      }
+      // those of some of the rejected events are accessed anyway
+      if ( ! e.selected && i%7 != 0 )
+      {
+         events.push_back(e);
+         continue;
+      }
+
+      // the summary first, its tree is read by the vertex collection
+      const VertexSummary & s = analysis.vertexSummary(summary);
+      if ( files -> tree(verticesPath) -> GetReadEntry() != i ) ++failed;
+      e.nVertices = s.n;
+      e.nGood = s.nGood;
+      if ( analysis.collection(vertices) -> size() != s.n ) ++failed;
+
+      auto c = analysis.collection(candidates);
+      if ( files -> tree(candidatesPath) -> GetReadEntry() != i ) ++failed;
+      e.n = c -> size();
+      for ( int j = 0 ; j < c -> size() ; ++j )
+         e.sumPt += c -> at(j).pt();
+      events.push_back(e);
+   }
+
+   MonitorInfo info = analysis.monitorInfo();
+   long npreselected = 0;
+   for ( auto & e : events ) npreselected += e.selected;
+   if ( info.events != (long) events.size() || ( mode > 0 && info.preselected != npreselected ) ) ++failed;
+   return events;
+}
+
+int main()
+{
+   std::string list = writeTestNtuple("testStagedReading", 100, 16);
+
+   int failed = 0;
+   std::vector<Event> sequential = readEvents(list, 0, failed);
+   if ( failed ) std::cout << "testStagedReading: " << failed << " failures in the sequential reading" << std::endl;
+   for ( int mode = 1 ; mode < 3 ; ++mode )
+   {
+      int f = 0;
+      std::vector<Event> events = readEvents(list, mode, f);
+      if ( events.size() != sequential.size() ) ++f;
+      for ( size_t i = 0 ; i < events.size() && i < sequential.size() ; ++i )
+      {
+         const Event & e = sequential[i];
+         if ( e.event != (int) i+1 ) ++f;
+         if ( e.n >= 0 && ( e.n != (int) i%5 || e.nVertices != 1 + (int) i%4 ) ) ++f;
+         if ( ! ( events[i] == e ) ) ++f;
+      }
+      if ( f ) std::cout << "testStagedReading: " << f << " failures in mode " << mode << std::endl;
+      failed += f;
+   }
+   if ( failed ) return 1;
+   std::cout << "testStagedReading: ok" << std::endl;
+   return 0;
+}
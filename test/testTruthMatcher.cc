@@ -0,0 +1,121 @@
+// The chained matching of TruthMatcher, with its eta-phi grid, gives the
+// same table as a brute force greedy matching over all pairs: closest pairs
+// first, each object used once, and only the matched objects of a level are
+// matched to the next one.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+#include "Analysis/Core/interface/Candidate.h"
+#include "Analysis/Core/interface/TruthMatcher.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+std::vector<Candidate> candidates(std::mt19937 & gen, const int & n)
+{
+   std::uniform_real_distribution<float> eta(-2.5, 2.5), phi(-M_PI, M_PI), pt(20, 200);
+   std::vector<Candidate> cands;
+   for ( int i = 0 ; i < n ; ++i )
+   {
+      float p = pt(gen), e = eta(gen);
+      cands.push_back(Candidate(p, e, phi(gen), p*std::cosh(e)));
+   }
+   return cands;
+}
+
+// for each object of to, the object of from it is matched to, -1 if none
+std::vector<int> greedy(const std::vector<Candidate> & from, const std::vector<bool> & active, const std::vector<Candidate> & to,
+                        const float & dRmax, const float & dPtRelMax)
+{
+   struct Pair { double dR2; int i; int j; };
+   std::vector<Pair> pairs;
+   for ( size_t i = 0 ; i < from.size() ; ++i )
+   {
+      if ( ! active[i] ) continue;
+      for ( size_t j = 0 ; j < to.size() ; ++j )
+      {
+         double deta = from[i].eta() - to[j].eta();
+         double dphi = std::remainder(from[i].phi() - to[j].phi(), 2*M_PI);
+         double dR2 = deta*deta + dphi*dphi;
+         if ( dR2 > dRmax*dRmax ) continue;
+         if ( dPtRelMax > 0 && std::fabs(to[j].pt() - from[i].pt()) > dPtRelMax*from[i].pt() ) continue;
+         pairs.push_back(Pair{dR2, (int) i, (int) j});
+      }
+   }
+   std::sort(pairs.begin(), pairs.end(),
+             [](const Pair & a, const Pair & b) { return a.dR2 < b.dR2 || ( a.dR2 == b.dR2 && ( a.i < b.i || ( a.i == b.i && a.j < b.j ) ) ); });
+   std::vector<int> previous(to.size(), -1);
+   std::vector<bool> used(from.size(), false);
+   for ( auto & pair : pairs )
+   {
+      if ( used[pair.i] || previous[pair.j] >= 0 ) continue;
+      used[pair.i] = true;
+      previous[pair.j] = pair.i;
+   }
+   return previous;
+}
+
+int main()
+{
+   std::mt19937 gen(7);
+   const float dRs[] = { 0.2, 0.4, 1.0, 2.5, 3.5, 7.0 };
+   int failed = 0;
+   int chains = 0;
+   TruthMatcher matcher;
+   for ( int trial = 0 ; trial < 3000 ; ++trial )
+   {
+      const float dRmax = dRs[trial%6];
+      const float dPtRelMax = trial%2 ? 0.5 : -1;
+      std::vector<Candidate> quarks = candidates(gen, 2 + gen()%6);
+      std::vector<Candidate> genJets = candidates(gen, gen()%30);
+      std::vector<Candidate> jets = candidates(gen, gen()%30);
+
+      matcher.clear();
+      matcher.add(CandidateView(quarks));
+      matcher.add(CandidateView(genJets), dRmax);
+      matcher.add(CandidateView(jets), dRmax, dPtRelMax);
+      matcher.match();
+      if ( matcher.size() != quarks.size() || matcher.levels() != 3 ) ++failed;
+
+      std::vector<int> previous1 = greedy(quarks, std::vector<bool>(quarks.size(), true), genJets, dRmax, -1);
+      std::vector<bool> active(genJets.size());
+      for ( size_t j = 0 ; j < genJets.size() ; ++j ) active[j] = previous1[j] >= 0;
+      std::vector<int> previous2 = greedy(genJets, active, jets, dRmax, dPtRelMax);
+
+      for ( size_t s = 0 ; s < quarks.size() ; ++s )
+      {
+         if ( matcher.index(s,0) != (int) s || matcher.object(s,0) != &quarks[s] ) ++failed;
+         // the reference chain of the source
+         int j1 = std::find(previous1.begin(), previous1.end(), (int) s) - previous1.begin();
+         if ( j1 == (int) genJets.size() ) j1 = -1;
+         int j2 = -1;
+         if ( j1 >= 0 )
+         {
+            j2 = std::find(previous2.begin(), previous2.end(), j1) - previous2.begin();
+            if ( j2 == (int) jets.size() ) j2 = -1;
+         }
+         if ( matcher.index(s,1) != j1 || matcher.index(s,2) != j2 ) ++failed;
+         if ( matcher.complete(s) != ( j2 >= 0 ) ) ++failed;
+         if ( j1 >= 0 && std::fabs(matcher.deltaR(s,1) - quarks[s].deltaR(genJets[j1])) > 1e-4 ) ++failed;
+         if ( j2 >= 0 )
+         {
+            if ( matcher.object(s,2) != &jets[j2] ) ++failed;
+            ++chains;
+         }
+         else if ( matcher.object(s,2) != nullptr || matcher.deltaR(s,2) != -1 ) ++failed;
+      }
+   }
+   if ( chains == 0 ) ++failed;
+
+   if ( failed )
+   {
+      std::cout << "testTruthMatcher: " << failed << " failures" << std::endl;
+      return 1;
+   }
+   std::cout << "testTruthMatcher: ok" << std::endl;
+   return 0;
+}
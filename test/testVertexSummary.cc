@@ -0,0 +1,65 @@
+// The vertex summary is the same with its own tree and with the tree of an
+// addTree<Vertex> of the same path, which is then not read twice, and with
+// the pipelined and the staged reading. The summary is not a collection.
+
+#include <iostream>
+#include <string>
+
+#include "Analysis/Core/interface/Analysis.h"
+#include "TestNtuple.h"
+
+using namespace analysis;
+using namespace analysis::tools;
+
+// reads the events; mode 0: summary only, 1: with addTree<Vertex> first, 2: pipelined, 3: staged
+int readEvents(const std::string & list, const int & mode)
+{
+   const std::string path = "MssmHbb/Events/primaryVertices";
+   int failed = 0;
+   Analysis analysis(list);
+   CollectionHandle<Vertex> vertices;
+   if ( mode == 1 ) vertices = analysis.addTree<Vertex>("Vertices", path);
+   SummaryHandle<VertexSummary> summary = analysis.addVertexSummary("VertexSummary", path);
+   if ( ! summary.valid() ) return 1;
+   if ( mode == 2 ) analysis.pipeline(true);
+   if ( mode == 3 ) analysis.stagedReading(true);
+
+   // not a collection
+   if ( analysis.handle<VertexSummary>("VertexSummary").valid() ) ++failed;
+
+   for ( int i = 0 ; i < analysis.size() ; ++i )
+   {
+      analysis.event(i);
+      const VertexSummary & s = analysis.vertexSummary(summary);
+      // 1 + i%4 vertices at z = 0.5*k, the third one fake
+      int n = 1 + i%4;
+      int ngood = n >= 3 ? n-1 : n;
+      float density = n >= 2 ? 0.5 : 0.;
+      if ( s.n != n || s.nGood != ngood || s.pvZ != 0 || ! s.pvGood ) ++failed;
+      if ( s.pvDensity != density ) ++failed;
+      if ( mode == 1 && (int) analysis.collection(vertices) -> size() != n ) ++failed;
+   }
+   analysis.pipeline(false);
+
+   // the tree of the Vertex collection is read once
+   MonitorInfo info = analysis.monitorInfo();
+   if ( mode == 1 && info.treeBytes.count("VertexSummary") != 0 ) ++failed;
+   if ( mode != 1 && info.treeBytes.count("VertexSummary") != 1 ) ++failed;
+   return failed;
+}
+
+int main()
+{
+   std::string list = writeTestNtuple("testVertexSummary", 40);
+
+   int failed = 0;
+   for ( int mode = 0 ; mode < 4 ; ++mode )
+   {
+      int f = readEvents(list, mode);
+      if ( f ) std::cout << "testVertexSummary: " << f << " failures in mode " << mode << std::endl;
+      failed += f;
+   }
+   if ( failed ) return 1;
+   std::cout << "testVertexSummary: ok" << std::endl;
+   return 0;
+}